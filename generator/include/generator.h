@@ -0,0 +1,111 @@
+#ifndef GENERATOR_H
+# define GENERATOR_H
+
+# include "lem_in.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+# define START_ID 0 // the two terminal rooms come first, then the planted
+# define END_ID 1	// paths, then the filler rooms
+# define FILLER_COLUMN 1024 // filler rooms are laid out in columns this tall
+# define MAX_RANDOM_LINKS 64 // per room, whatever the density
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef enum e_style
+{
+	STYLE_FLOW_ONE = 0,
+	STYLE_FLOW_TEN,
+	STYLE_FLOW_THOUSAND,
+	STYLE_BIG,
+	STYLE_BIG_SUPERPOSITION,
+	STYLE_SNAIL,
+	STYLE_GRID,
+	STYLE_BIPARTITE,
+	STYLE_COUNT
+} t_style;
+
+// Command line, 0 meaning "use the style default" for every size
+typedef struct s_gen_options
+{
+	t_style style;
+	uint64_t seed;
+	size_t rooms;	// total rooms, start and end included
+	size_t ants;
+	size_t length;	// rooms on each planted path
+	size_t density; // random links per 100 rooms (cross-links for bipartite)
+	bool density_set;
+} t_gen_options;
+
+// splitmix64: tiny, seedable and the same stream on every platform
+typedef struct s_rng
+{
+	uint64_t state;
+} t_rng;
+
+// Every map is a set of disjoint start-end paths ("chains") over
+// consecutive room ids, plus style-specific cross-links between
+// neighbouring chains and random links. Chain c holds the rooms
+// [chain_first[c], chain_first[c + 1]).
+typedef struct s_layout
+{
+	t_style style;
+	uint64_t seed;
+	size_t room_count;
+	size_t ants;
+	size_t density;
+	size_t chain_count;
+	uint32_t *chain_first; // chain_count + 1 entries
+	size_t filler_first;   // first room that belongs to no chain
+	size_t required;	   // turns needed on the planted chains alone
+} t_layout;
+
+// ============================================================================
+// FUNCTION PROTOTYPES
+// ============================================================================
+
+// options functions
+bool gen_parse_options(int argc, char **argv, t_gen_options *options);
+const char *style_name(t_style style);
+
+// layout functions
+bool layout_build(t_layout *layout, const t_gen_options *options);
+void layout_destroy(t_layout *layout);
+
+// output functions
+bool emit_map(const t_layout *layout);
+
+// ============================================================================
+// RANDOM NUMBERS
+// ============================================================================
+
+static inline void rng_seed(t_rng *rng, uint64_t seed)
+{
+	rng->state = seed;
+}
+
+static inline uint64_t rng_next(t_rng *rng)
+{
+	uint64_t z = (rng->state += 0x9e3779b97f4a7c15ull);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+// uniform in [0, bound), bound > 0; the modulo bias is irrelevant here
+static inline size_t rng_below(t_rng *rng, size_t bound)
+{
+	return (size_t)(rng_next(rng) % bound);
+}
+
+static inline size_t chain_len(const t_layout *layout, size_t c)
+{
+	return layout->chain_first[c + 1] - layout->chain_first[c];
+}
+
+#endif
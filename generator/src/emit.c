@@ -0,0 +1,251 @@
+#include "generator.h"
+
+/* ============================================================================
+ *                               MAP OUTPUT
+ *
+ * Rooms and links are streamed through the lem-in writer, nothing but the
+ * chain offsets is kept in memory, so the room count is only bounded by
+ * the output size. Room i is named "r<i>".
+ * ============================================================================ */
+
+// literal strings only: their length is known at compile time
+#define WRITE_LITERAL(out, lit) writer_str(out, lit, sizeof(lit) - 1)
+
+static void emit_room(t_writer *out, size_t id, size_t x, size_t y)
+{
+	writer_char(out, 'r');
+	writer_number(out, id);
+	writer_char(out, ' ');
+	writer_number(out, x);
+	writer_char(out, ' ');
+	writer_number(out, y);
+	writer_char(out, '\n');
+}
+
+static void emit_link(t_writer *out, size_t a, size_t b)
+{
+	writer_char(out, 'r');
+	writer_number(out, a);
+	WRITE_LITERAL(out, "-r");
+	writer_number(out, b);
+	writer_char(out, '\n');
+}
+
+static void emit_header(t_writer *out, const t_layout *layout)
+{
+	const char *name = style_name(layout->style);
+
+	writer_number(out, layout->ants);
+	WRITE_LITERAL(out, "\n#Here is the number of lines required: ");
+	writer_number(out, layout->required);
+	WRITE_LITERAL(out, "\n#generator --style=");
+	writer_str(out, name, ft_strlen(name));
+	WRITE_LITERAL(out, " --seed=");
+	writer_number(out, layout->seed);
+	WRITE_LITERAL(out, " --rooms=");
+	writer_number(out, layout->room_count);
+	WRITE_LITERAL(out, " --ants=");
+	writer_number(out, layout->ants);
+	WRITE_LITERAL(out, "\n##start\n");
+	emit_room(out, START_ID, 0, 0);
+	WRITE_LITERAL(out, "##end\n");
+	emit_room(out, END_ID, 0, 1);
+}
+
+// chain c on column c + 1, filler rooms in columns of FILLER_COLUMN after it
+static void emit_rooms(t_writer *out, const t_layout *layout)
+{
+	size_t filler;
+
+	for (size_t c = 0; c < layout->chain_count; c++)
+	{
+		for (size_t id = layout->chain_first[c]; id < layout->chain_first[c + 1]; id++)
+			emit_room(out, id, c + 1, id - layout->chain_first[c]);
+	}
+	for (size_t id = layout->filler_first; id < layout->room_count; id++)
+	{
+		filler = id - layout->filler_first;
+		emit_room(out, id, layout->chain_count + 1 + filler / FILLER_COLUMN, filler % FILLER_COLUMN);
+	}
+}
+
+static void emit_chains(t_writer *out, const t_layout *layout)
+{
+	for (size_t c = 0; c < layout->chain_count; c++)
+	{
+		emit_link(out, START_ID, layout->chain_first[c]);
+		for (size_t id = layout->chain_first[c] + 1; id < layout->chain_first[c + 1]; id++)
+			emit_link(out, id - 1, id);
+		emit_link(out, layout->chain_first[c + 1] - 1, END_ID);
+	}
+}
+
+// k distinct values in [low, high), high - low >= k
+static void draw_distinct(t_rng *rng, size_t *values, size_t k, size_t low, size_t high)
+{
+	for (size_t i = 0; i < k; i++)
+	{
+		bool taken;
+
+		do
+		{
+			values[i] = low + rng_below(rng, high - low);
+			taken = false;
+			for (size_t j = 0; j < i && !taken; j++)
+				taken = values[j] == values[i];
+		} while (taken);
+	}
+}
+
+// density / 100 links, plus one more with probability (density % 100) %
+static size_t links_per_room(t_rng *rng, size_t density, size_t limit)
+{
+	size_t k = density / 100 + (rng_below(rng, 100) < density % 100);
+
+	if (k > MAX_RANDOM_LINKS)
+		k = MAX_RANDOM_LINKS;
+	return k < limit ? k : limit;
+}
+
+// big-superposition: a few links from each path to one room further on
+// the next one, so that the shortest routes overlap and the first paths
+// found block the others
+static void emit_superposition(t_writer *out, const t_layout *layout, t_rng *rng)
+{
+	size_t k, p;
+
+	for (size_t c = 0; c + 1 < layout->chain_count; c++)
+	{
+		k = 1 + rng_below(rng, 3);
+		for (size_t i = 0; i < k; i++)
+		{
+			p = rng_below(rng, chain_len(layout, c));
+			if (p + 1 < chain_len(layout, c + 1))
+				emit_link(out, layout->chain_first[c] + p, layout->chain_first[c + 1] + p + 1);
+		}
+	}
+}
+
+// snail: rungs from each path to one step further on the next path, every
+// third room; a bfs happily zig-zags across them and blocks both paths
+static void emit_snail(t_writer *out, const t_layout *layout)
+{
+	size_t len;
+
+	for (size_t c = 0; c + 1 < layout->chain_count; c++)
+	{
+		len = chain_len(layout, c);
+		for (size_t j = 0; j + 1 < len; j += 3)
+			emit_link(out, layout->chain_first[c] + j, layout->chain_first[c + 1] + j + 1);
+	}
+}
+
+// grid: every row is a path, columns link the rows together
+static void emit_grid(t_writer *out, const t_layout *layout)
+{
+	for (size_t c = 0; c + 1 < layout->chain_count; c++)
+	{
+		for (size_t j = 0; j < chain_len(layout, c); j++)
+			emit_link(out, layout->chain_first[c] + j, layout->chain_first[c + 1] + j);
+	}
+}
+
+// bipartite: path c is a_c - b_c, and a_c also reaches density / 100
+// other b rooms chosen at distinct offsets, so no link is repeated
+static void emit_bipartite(t_writer *out, const t_layout *layout, t_rng *rng)
+{
+	size_t offsets[MAX_RANDOM_LINKS];
+	size_t count = layout->chain_count;
+	size_t k;
+
+	if (count < 2)
+		return;
+	for (size_t c = 0; c < count; c++)
+	{
+		k = links_per_room(rng, layout->density, count - 1);
+		draw_distinct(rng, offsets, k, 1, count);
+		for (size_t i = 0; i < k; i++)
+			emit_link(out, layout->chain_first[c], layout->chain_first[(c + offsets[i]) % count] + 1);
+	}
+}
+
+// random links that keep the planted paths the shortest ones: path room
+// (c, p) links to (c + o, p) or (c + o, p + 1), so no link moves an ant
+// more than one room closer to end. Drawing distinct offsets o below
+// count / 2 means a pair is never drawn again from its other end.
+static void emit_path_links(t_writer *out, const t_layout *layout, t_rng *rng)
+{
+	size_t offsets[MAX_RANDOM_LINKS];
+	size_t count = layout->chain_count;
+	size_t k, other, q;
+
+	for (size_t c = 0; c < count; c++)
+	{
+		for (size_t p = 0; p < chain_len(layout, c); p++)
+		{
+			k = links_per_room(rng, layout->density, count / 2 - 1);
+			draw_distinct(rng, offsets, k, 1, count / 2);
+			for (size_t i = 0; i < k; i++)
+			{
+				other = (c + offsets[i]) % count;
+				q = p + rng_below(rng, 2);
+				if (q < chain_len(layout, other))
+					emit_link(out, layout->chain_first[c] + p, layout->chain_first[other] + q);
+			}
+		}
+	}
+}
+
+// filler rooms are side rooms: each one links to rooms of distinct paths,
+// at its own distance from start where the path is long enough. On a
+// shorter path it takes the last room instead, so every drawn link exists
+// and every filler reaches a path, but such a filler can join the end of a
+// short path to the middle of a longer one, a possible shortcut
+static void emit_filler_links(t_writer *out, const t_layout *layout, t_rng *rng)
+{
+	size_t offsets[MAX_RANDOM_LINKS];
+	size_t count = layout->chain_count;
+	size_t k, base, depth, other;
+
+	for (size_t id = layout->filler_first; id < layout->room_count; id++)
+	{
+		k = links_per_room(rng, layout->density + 100, count);
+		base = rng_below(rng, count);
+		depth = rng_below(rng, chain_len(layout, base));
+		draw_distinct(rng, offsets, k, 0, count);
+		for (size_t i = 0; i < k; i++)
+		{
+			other = (base + offsets[i]) % count;
+			if (depth < chain_len(layout, other))
+				emit_link(out, id, layout->chain_first[other] + depth);
+			else
+				emit_link(out, id, layout->chain_first[other + 1] - 1);
+		}
+	}
+}
+
+bool emit_map(const t_layout *layout)
+{
+	t_writer out;
+	t_rng rng;
+
+	if (!writer_init(&out, STDOUT_FILENO))
+		return false;
+	// links draw from their own stream so the layout does not shift them
+	rng_seed(&rng, ~layout->seed);
+	emit_header(&out, layout);
+	emit_rooms(&out, layout);
+	emit_chains(&out, layout);
+	if (layout->style == STYLE_BIG_SUPERPOSITION)
+		emit_superposition(&out, layout, &rng);
+	else if (layout->style == STYLE_SNAIL)
+		emit_snail(&out, layout);
+	else if (layout->style == STYLE_GRID)
+		emit_grid(&out, layout);
+	if (layout->style == STYLE_BIPARTITE)
+		emit_bipartite(&out, layout, &rng);
+	else if (layout->density > 0 && layout->chain_count >= 4)
+		emit_path_links(&out, layout, &rng);
+	emit_filler_links(&out, layout, &rng);
+	return writer_destroy(&out);
+}
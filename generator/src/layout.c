@@ -0,0 +1,164 @@
+#include "generator.h"
+
+/* ============================================================================
+ *                               LAYOUT
+ *
+ * Decide how many rooms each planted path gets. The flow and big styles
+ * draw lengths between length and 1.5 * length until fill_percent of the
+ * rooms are used, the rest becoming filler reached only by random links.
+ * snail, grid and bipartite cut all the rooms into equal paths.
+ * ============================================================================ */
+
+typedef struct s_style_defaults
+{
+	size_t rooms;
+	size_t ants;
+	size_t length; // 0: derived from the room count
+	size_t density;
+	size_t fill_percent;
+} t_style_defaults;
+
+static const t_style_defaults g_defaults[STYLE_COUNT] = {
+	[STYLE_FLOW_ONE] = {370, 1, 35, 60, 60},
+	[STYLE_FLOW_TEN] = {370, 10, 30, 60, 60},
+	[STYLE_FLOW_THOUSAND] = {590, 100, 25, 60, 60},
+	[STYLE_BIG] = {3000, 430, 40, 80, 60},
+	[STYLE_BIG_SUPERPOSITION] = {4200, 225, 45, 60, 60},
+	[STYLE_SNAIL] = {10002, 200, 0, 0, 100},
+	[STYLE_GRID] = {10002, 100, 0, 0, 100},
+	[STYLE_BIPARTITE] = {10002, 500, 2, 300, 100},
+};
+
+static bool jittered(t_style style)
+{
+	return style <= STYLE_BIG_SUPERPOSITION;
+}
+
+static size_t isqrt(size_t n)
+{
+	size_t root = 0;
+
+	while ((root + 1) * (root + 1) <= n)
+		root++;
+	return root;
+}
+
+static size_t default_length(const t_layout *layout, size_t inner)
+{
+	if (layout->style == STYLE_SNAIL)
+		return inner / 4 ? inner / 4 : 1;
+	if (layout->style == STYLE_GRID)
+		return isqrt(inner) ? isqrt(inner) : 1;
+	return g_defaults[layout->style].length;
+}
+
+static int compare_sizes(const void *a, const void *b)
+{
+	size_t la = *(const size_t *)a;
+	size_t lb = *(const size_t *)b;
+
+	return (la > lb) - (la < lb);
+}
+
+// same water-fill as count_output_lines in the solver: the turns needed
+// to route every ant through the planted paths only, an upper bound on
+// the optimum since the other links can only open shorter routes
+static bool required_lines(t_layout *layout)
+{
+	size_t *len;
+	size_t sum = 0, lines = 0;
+
+	if (!(len = malloc(layout->chain_count * sizeof(size_t))))
+		return false;
+	for (size_t c = 0; c < layout->chain_count; c++)
+		len[c] = chain_len(layout, c) + 1;
+	qsort(len, layout->chain_count, sizeof(size_t), compare_sizes);
+	for (size_t m = 1; m <= layout->chain_count; m++)
+	{
+		sum += len[m - 1];
+		lines = (layout->ants + sum + m - 1) / m - 1;
+		if (m == layout->chain_count || lines <= len[m] - 1)
+			break;
+	}
+	free(len);
+	layout->required = lines;
+	return true;
+}
+
+static bool plant_jittered(t_layout *layout, t_rng *rng, size_t budget, size_t length)
+{
+	size_t used = 0, len;
+
+	if (!(layout->chain_first = malloc((budget / length + 2) * sizeof(uint32_t))))
+		return false;
+	layout->chain_first[0] = 2;
+	layout->chain_count = 0;
+	while (used < budget)
+	{
+		len = length + rng_below(rng, length / 2 + 1);
+		if (len > budget - used)
+		{
+			if (layout->chain_count > 0)
+				break;
+			len = budget - used;
+		}
+		used += len;
+		layout->chain_count++;
+		layout->chain_first[layout->chain_count] = (uint32_t)(2 + used);
+	}
+	return true;
+}
+
+static bool plant_fixed(t_layout *layout, size_t inner, size_t length)
+{
+	size_t count = inner / length;
+
+	if (count == 0)
+	{
+		count = 1;
+		length = inner;
+	}
+	if (!(layout->chain_first = malloc((count + 1) * sizeof(uint32_t))))
+		return false;
+	for (size_t c = 0; c <= count; c++)
+		layout->chain_first[c] = (uint32_t)(2 + c * length);
+	layout->chain_count = count;
+	return true;
+}
+
+bool layout_build(t_layout *layout, const t_gen_options *options)
+{
+	const t_style_defaults *defaults = &g_defaults[options->style];
+	size_t inner, length, budget;
+	t_rng rng;
+
+	ft_bzero(layout, sizeof(*layout));
+	layout->style = options->style;
+	layout->seed = options->seed;
+	layout->room_count = options->rooms ? options->rooms : defaults->rooms;
+	layout->ants = options->ants ? options->ants : defaults->ants;
+	layout->density = options->density_set ? options->density : defaults->density;
+	if (layout->room_count < 3 || layout->room_count > MAX_ROOMS)
+	{
+		ft_putstr_fd("generator: --rooms must be between 3 and MAX_ROOMS\n", STDERR_FILENO);
+		return false;
+	}
+	inner = layout->room_count - 2;
+	length = options->length ? options->length : default_length(layout, inner);
+	if (layout->style == STYLE_BIPARTITE)
+		length = 2;
+	rng_seed(&rng, layout->seed);
+	budget = inner * defaults->fill_percent / 100;
+	if (jittered(layout->style) && !plant_jittered(layout, &rng, budget ? budget : 1, length))
+		return false;
+	if (!jittered(layout->style) && !plant_fixed(layout, inner, length))
+		return false;
+	layout->filler_first = layout->chain_first[layout->chain_count];
+	return required_lines(layout);
+}
+
+void layout_destroy(t_layout *layout)
+{
+	free(layout->chain_first);
+	layout->chain_first = NULL;
+}
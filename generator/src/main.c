@@ -0,0 +1,15 @@
+#include "generator.h"
+
+int main(int argc, char **argv)
+{
+	t_gen_options options;
+	t_layout layout;
+	int status = EXIT_SUCCESS;
+
+	if (!gen_parse_options(argc, argv, &options))
+		return EXIT_FAILURE;
+	if (!layout_build(&layout, &options) || !emit_map(&layout))
+		status = EXIT_FAILURE;
+	layout_destroy(&layout);
+	return status;
+}
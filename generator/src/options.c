@@ -0,0 +1,116 @@
+#include "generator.h"
+
+static const char *g_style_names[STYLE_COUNT] = {
+	[STYLE_FLOW_ONE] = "flow-one",
+	[STYLE_FLOW_TEN] = "flow-ten",
+	[STYLE_FLOW_THOUSAND] = "flow-thousand",
+	[STYLE_BIG] = "big",
+	[STYLE_BIG_SUPERPOSITION] = "big-superposition",
+	[STYLE_SNAIL] = "snail",
+	[STYLE_GRID] = "grid",
+	[STYLE_BIPARTITE] = "bipartite",
+};
+
+const char *style_name(t_style style)
+{
+	return g_style_names[style];
+}
+
+static void usage(void)
+{
+	ft_putstr_fd(
+		"usage: generator [--style=NAME | --NAME] [--seed=N] [--rooms=N]\n"
+		"                 [--ants=N] [--length=N] [--density=N]\n"
+		"\n"
+		"  NAME       flow-one, flow-ten, flow-thousand, big, big-superposition,\n"
+		"             snail, grid or bipartite (default: big)\n"
+		"  --seed     same seed and options, same map (default: 1)\n"
+		"  --rooms    total rooms, start and end included\n"
+		"  --ants     number of ants, at most 2147483647 like lem-in\n"
+		"  --length   rooms on each planted path (snail and grid: path length)\n"
+		"  --density  random links per 100 rooms (bipartite: cross-links)\n",
+		STDERR_FILENO);
+}
+
+static bool option_error(const char *arg)
+{
+	ft_putstr_fd("generator: invalid option '", STDERR_FILENO);
+	ft_putstr_fd(arg, STDERR_FILENO);
+	ft_putstr_fd("'\n", STDERR_FILENO);
+	usage();
+	return false;
+}
+
+// decimal, no sign, no overflow
+static bool parse_size(const char *str, size_t *value)
+{
+	size_t result = 0;
+
+	if (!*str)
+		return false;
+	for (; *str; str++)
+	{
+		if (*str < '0' || *str > '9' || result > (SIZE_MAX - 9) / 10)
+			return false;
+		result = result * 10 + (size_t)(*str - '0');
+	}
+	*value = result;
+	return true;
+}
+
+static bool parse_style(const char *name, t_gen_options *options)
+{
+	for (int style = 0; style < STYLE_COUNT; style++)
+	{
+		if (ft_strncmp(name, g_style_names[style], ft_strlen(g_style_names[style]) + 1) == 0)
+		{
+			options->style = (t_style)style;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool parse_one(const char *arg, t_gen_options *options)
+{
+	size_t seed;
+
+	if (ft_strncmp(arg, "--style=", 8) == 0)
+		return parse_style(arg + 8, options);
+	if (ft_strncmp(arg, "--seed=", 7) == 0)
+	{
+		if (!parse_size(arg + 7, &seed))
+			return false;
+		options->seed = seed;
+		return true;
+	}
+	if (ft_strncmp(arg, "--rooms=", 8) == 0)
+		return parse_size(arg + 8, &options->rooms) && options->rooms > 0;
+	if (ft_strncmp(arg, "--ants=", 7) == 0)
+		return parse_size(arg + 7, &options->ants) && options->ants > 0
+			&& options->ants <= INT32_MAX; // lem-in's own limit
+	if (ft_strncmp(arg, "--length=", 9) == 0)
+		return parse_size(arg + 9, &options->length) && options->length > 0;
+	if (ft_strncmp(arg, "--density=", 10) == 0)
+		return (options->density_set = parse_size(arg + 10, &options->density));
+	// the switches of the prebuilt generator: --flow-one, --big, ...
+	return arg[0] == '-' && arg[1] == '-' && parse_style(arg + 2, options);
+}
+
+bool gen_parse_options(int argc, char **argv, t_gen_options *options)
+{
+	ft_bzero(options, sizeof(*options));
+	options->style = STYLE_BIG;
+	options->seed = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		if (ft_strncmp(argv[i], "--help", 7) == 0)
+		{
+			usage();
+			return false;
+		}
+		if (!parse_one(argv[i], options))
+			return option_error(argv[i]);
+	}
+	return true;
+}
@@ -11,12 +11,18 @@
 // CONSTANTS AND LIMITS
 // ============================================================================
 
-# define MAX_INPUT_SIZE (1 << 20) // 1MB
-# define INVALID_ROOM_ID UINT16_MAX
-# define HASH_SIZE 32768
-
-# define MAX_ROOMS 20000
-# define MAX_LINKS 200000
+# define INPUT_CHUNK_SIZE (1 << 16) // 64KB read granularity for pipes
+# define OUTPUT_BUFFER_SIZE (1 << 18) // 256KB ant-move output buffer
+# define INVALID_ROOM_ID UINT32_MAX
+# define ROOMS_INITIAL_CAPACITY 64 // parser tables start small and double
+# define LINKS_INITIAL_CAPACITY 128
+# define ARENA_BLOCK_SIZE (1 << 16) // smallest block the arena asks malloc for
+# define HASH_INITIAL_SIZE 128 // power of two, kept at most half full
+
+// Room ids and CSR offsets are 32 bits wide, and the vertex-split engine
+// uses 2 nodes per room and 4 arcs per link: keep all of them in range.
+# define MAX_ROOMS (UINT32_MAX / 8)
+# define MAX_LINKS (UINT32_MAX / 8)
 
 # define INCREASE 1
 # define DECREASE -1
@@ -42,88 +48,256 @@ typedef enum s_room_flags
 	ROOM_END = 2,
 } room_flags_t;
 
-typedef struct s_room
-{
-	const char *name;	// points inside input buffer
-	int32_t x, y;		// coordinates (can be negative)
-	room_flags_t flags; // room type and state
-	uint16_t id;		// unique room identifier
-} room_t;
-
 typedef struct s_link
 {
-	uint16_t from; // source room id
-	uint16_t to;   // destination room id
+	uint32_t from; // source room id
+	uint32_t to;   // destination room id
 } link_t;
 
+// Names are stored as offsets into the input buffer, which may still be
+// reallocated while a pipe is being read
 typedef struct s_hash_entry
 {
-	const char *name;
-	uint16_t room_id;
+	size_t name_offset;
+	uint32_t hash;	   // cached hash_string(name, name_len)
+	uint32_t room_id;
+	uint16_t name_len; // 0 marks an empty slot
 } hash_entry_t;
 
+typedef struct s_span
+{
+	size_t offset; // start inside input_buffer
+	size_t len;	   // bytes covered, '\n' separators included
+} span_t;
+
+// What scan_line found in one line, in a single pass
+typedef struct s_line_scan
+{
+	char *end;		// first '\n' or '\r', or the end of the data
+	char *blank[2]; // first two spaces or tabs
+	char *dash;		// first '-', NULL if there is none
+	size_t blanks;	// spaces and tabs in the line
+	bool has_nul;	// a '\0' hides the rest of the line from the checks
+} line_scan_t;
 
 
-typedef struct s_edge
+typedef enum e_stage
+{
+	STAGE_READ_INPUT = 0,
+	STAGE_PARSE_INPUT,
+	STAGE_GRAPH_BUILDER,
+	STAGE_CHECK_PATH, // is there a path at all, before the map is echoed
+	STAGE_FIND_PATHS,
+	STAGE_FIND_SOLUTION,
+	STAGE_DISPLAY,
+	STAGE_COUNT
+} t_stage;
+
+// Timings and counters of one run, always collected and printed with
+// --stats. The engines reach it through graph->stats.
+typedef struct s_stats
+{
+	uint64_t stage_ns[STAGE_COUNT];
+	uint64_t since;			 // clock reading that opens the current stage
+	size_t bfs_calls;		 // searches run by either engine
+	size_t edges_relaxed;	 // edges (or split arcs) scanned by those searches
+	size_t augment_accepted; // augmentations that lowered the turn count
+	size_t augment_rejected; // augmentations that did not
+	size_t arena_blocks;	 // heap blocks requested by the graph arenas
+	size_t budget_expired;	 // 1 when the search stopped on its budget
+	size_t early_stop;		 // 1 when it stopped since no path could help
+	size_t rooms_pruned;	 // dead-end rooms dropped before the search
+	size_t rooms_contracted; // corridor rooms folded into split graph arcs
+} t_stats;
+
+// Limits of an anytime search (--budget, --budget-bfs). Once one is hit
+// the engine stops between two augmentations and keeps its best path set.
+typedef struct s_budget
 {
-	size_t dest;
-	size_t capacity;
-	struct s_edge *next;
-} t_edge;
+	uint64_t deadline_ns; // CLOCK_MONOTONIC reading, 0: no time limit
+	size_t bfs_base;	  // stats->bfs_calls when the search started
+	size_t max_bfs;		  // searches allowed from there, 0: no limit
+} t_budget;
+
+// Bump allocator: every per-run allocation of the graph, the bfs, the
+// split engine and the solver comes from graph->arena and is released at
+// once by free_graph. Scratch space is given back with a mark/rewind pair.
+typedef struct s_arena_block
+{
+	struct s_arena_block *next; // previously allocated block
+	size_t size;
+	size_t used;
+	_Alignas(16) unsigned char data[];
+} t_arena_block;
 
+typedef struct s_arena
+{
+	t_arena_block *head;
+	t_arena_block *spare; // largest block given back by a rewind
+	size_t allocations;	  // blocks requested from malloc so far
+} t_arena;
 
+typedef struct s_arena_mark
+{
+	t_arena_block *block;
+	size_t used;
+} t_arena_mark;
+
+// Rooms are written here by the parser and handed over to the graph as
+// they are: the name stays in the input buffer
 typedef struct s_node
 {
-	t_edge *head;
-	int index;
+	size_t name_offset;	// into graph->input, not NUL-terminated
 	room_flags_t flags;
-	uint8_t bfs_marked;
-	uint8_t enqueued;
-	uint8_t enqueued_backward;
-	char padding[7];
-	char *name;
+	uint16_t name_len;	// at most 255
 } t_node;
 
+// Search workspace of the heuristic engine, allocated once with the graph
+// and reused by every bfs. Nothing is cleared between searches: each bfs
+// runs under a new epoch, and a node's marks and prev entry only count when
+// stamped with the current one.
+typedef struct s_bfs
+{
+	uint32_t *mark_stamp;	 // node is bfs-marked when == epoch
+	uint32_t *enqueue_stamp; // node was reached (prev is valid) this epoch
+	uint32_t *path_stamp;	 // node lies on the path being reset
+	uint32_t *route_stamp;	 // node lies on the path the bfs works around
+	uint32_t *kept;			 // marked nodes carried over to the next bfs
+	uint32_t *touched;		 // nodes first marked by the current bfs
+	size_t kept_count;
+	size_t touched_count;
+	uint32_t epoch;
+	uint32_t *path; // rooms of the path found, from start to end
+	size_t path_len;
+	ssize_t *queue;
+	ssize_t *prev;
+	size_t queue_front;
+	size_t queue_rear;
+	size_t queue_size;
+	size_t queue_capacity;
+	size_t node;
+} t_bfs;
+
+// Chains of rooms of degree 2 between two other rooms (graph_reduce.c).
+// Corridor c holds rooms[first[c]] .. rooms[first[c + 1] - 1], listed from
+// end_a to end_b; edge_corridor[e] is the corridor edge e leads into, or
+// the one its room lies in
+typedef struct s_corridors
+{
+	uint32_t *edge_corridor; // edge_count entries, NO_CORRIDOR if none
+	uint32_t *first;		 // count + 1 entries
+	uint32_t *rooms;
+	uint32_t *end_a;
+	uint32_t *end_b;
+	size_t count;
+} t_corridors;
+
+# define NO_CORRIDOR UINT32_MAX
+
+// Adjacency is stored in CSR form: the edges leaving node u are the
+// indices [edge_offset[u], edge_offset[u + 1]). Every link gives two
+// directed edges that reference each other through edge_twin.
 typedef struct s_graph
 {
-	t_node *nodes;
+	t_arena arena; // owns every array below
+	t_stats *stats;
+	const t_budget *budget; // set by search_paths, NULL when unbounded
+	const char *input; // the parser's input buffer, holds the room names
+	t_node *nodes;	   // adopted from the parser, freed by free_graph
+	uint32_t *edge_offset;	// size + 1 entries
+	uint32_t *edge_dest;	// destination room of each edge
+	uint32_t *edge_twin;	// index of the reverse edge
+	uint8_t *edge_capacity; // residual capacity (0, 1 or 2)
+	size_t edge_count;
+	t_bfs search; // workspace shared by every bfs of the heuristic engine
+	t_corridors corridors; // folded into single arcs by the split graph
+	uint8_t *room_used; // path_set_is_valid scratch, all zero between calls
 	size_t ants;
 	size_t size;
 	size_t start_room_id;
 	size_t end_room_id;
 	size_t paths_count;
 	size_t old_output_lines;
+	size_t lines_bound; // no path set can take fewer turns (search_bound.c)
 } t_graph;
 
-typedef struct s_bfs
+
+// Every path of a solution lives in one flat array of room ids:
+// path i is rooms[offset[i]] .. rooms[offset[i + 1] - 1], start to end.
+typedef struct s_path_set
 {
-	t_list *shortest_path;
-	t_edge *neighbours;
-	t_edge *neighbours2;
-	ssize_t *queue;
-	ssize_t *prev;
-	size_t queue_front;
-	size_t queue_rear;
-	size_t queue_size;
-	size_t queue_capacity;
-	size_t node;
-} t_bfs;
+	uint32_t *rooms;
+	size_t *offset; // count + 1 entries
+	size_t count;
+	size_t room_capacity;
+	size_t path_capacity;
+} t_path_set;
 
 typedef struct s_paths
 {
-	t_list **array;
-	size_t *ants_to_paths;
+	const t_path_set *set; // borrowed from the engine, never copied
 	size_t *n;
 	size_t *len;
 	size_t output_lines;
-	uint8_t *available;
-	t_edge *neighbours;
-	t_edge *neighbours2;
 } t_paths;
 
+// Residual graph for the vertex-split engine: room v becomes v_in (2v)
+// and v_out (2v + 1) joined by a unit arc, in the same CSR layout as t_graph.
+// A corridor becomes one arc between its end rooms; its own rooms get none
+typedef struct s_split_graph
+{
+	t_arena *arena;	   // split_destroy rewinds graph->arena to mark
+	t_arena_mark mark;
+	t_stats *stats;	   // graph->stats
+	uint32_t *offset;	// node_count + 1 entries
+	uint32_t *dest;
+	uint32_t *twin;
+	uint8_t *capacity;	// residual capacity
+	uint8_t *forward;	// TRUE for original arcs, FALSE for residual twins
+	uint32_t *links;	// links an arc stands for: 0 inside a room, 1 + corridor rooms
+	uint32_t *via;		// corridor an arc crosses, NO_CORRIDOR if none
+	uint32_t *dist;		// search distance, valid where visited is the epoch
+	uint32_t *bucket_head; // bucket_count FIFO lists of search entries
+	uint32_t *bucket_tail;
+	uint32_t *entry_node;  // arc_count + 1 entries
+	uint32_t *entry_next;
+	uint32_t bucket_count;
+	uint32_t *prev_arc; // arc used to reach each node in the last bfs
+	uint32_t *visited;	// bfs epoch that last reached each node
+	uint32_t epoch;
+	size_t node_count;
+	size_t arc_count;
+	size_t source; // start_out
+	size_t sink;   // end_in
+} t_split_graph;
+
+# define SPLIT_IN(v) ((v) * 2)
+# define SPLIT_OUT(v) ((v) * 2 + 1)
+# define SPLIT_ROOM(n) ((n) / 2)
+
+typedef struct s_writer
+{
+	char *buf;
+	size_t len;
+	int fd;
+	bool failed;
+} t_writer;
+
+typedef enum e_engine
+{
+	ENGINE_SPLIT = 0, // Edmonds-Karp on the vertex-split graph (default)
+	ENGINE_HEURISTIC, // augment-and-compare search of paths_finder.c
+	ENGINE_MINCOST,	  // successive shortest paths, Dijkstra with potentials
+	ENGINE_PORTFOLIO, // every engine at once, the fewest turns wins
+} t_engine;
+
 typedef struct
 {
-	
+	t_engine engine;
+	bool stats;				// --stats: report timings and counters
+	const char *stats_path; // --stats=FILE: as JSON into FILE, else stderr
+	size_t budget_ms;		// --budget=MS: wall-clock limit of the search
+	size_t budget_bfs;		// --budget-bfs=N: limit on its bfs calls
 } t_options;
 
 // ============================================================================
@@ -157,7 +331,9 @@ typedef enum
 	ERR_INVALID_LINE,
 	ERR_TOO_MANY_ROOMS,
 	ERR_TOO_MANY_LINKS,
-	ERR_NO_PATH
+	ERR_NO_PATH,
+	ERR_INVALID_OPTION,
+	ERR_STATS_OUTPUT
 } error_code_t;
 
 // ============================================================================
@@ -168,23 +344,74 @@ typedef struct
 {
 	char *input_buffer;
 	size_t input_size;
+	size_t input_map_size; // non-zero when input_buffer is an mmap of stdin
 
-	room_t *rooms;
-	link_t *links;
-	hash_entry_t *hash_table;
+	t_node *nodes;			  // taken over by graph_builder
+	link_t *links;			  // freed once the graph edges are built
+	hash_entry_t *hash_table; // freed with the links
 
 	size_t room_count;
+	size_t room_capacity;
 	size_t link_count;
-	uint16_t start_room_id;
-	uint16_t end_room_id;
+	size_t link_capacity;
+	size_t hash_size; // slots in hash_table, a power of two
+	uint32_t start_room_id;
+	uint32_t end_room_id;
 
 	int32_t ant_count;
 	bool has_start;
 	bool has_end;
 
-	t_list *file_content;
+	span_t *echo_spans; // runs of accepted lines, echoed verbatim
+	size_t echo_count;
+	size_t echo_capacity;
+
+	// Lines are parsed as soon as they are complete, so a pipe is parsed
+	// chunk by chunk while it is being read
+	size_t parse_offset; // first byte of input_buffer not parsed yet
+	int next_flag;		 // 0 = normal, 1 = ##start, 2 = ##end
+	bool found_ant_count;
+	bool parse_done; // an empty line ended the map
 } lem_in_parser_t;
 
+// ============================================================================
+// BFS MARKS
+// ============================================================================
+
+static inline int8_t is_marked(const t_graph *graph, size_t node)
+{
+	return graph->search.mark_stamp[node] == graph->search.epoch;
+}
+
+static inline void mark_node(t_graph *graph, size_t node)
+{
+	if (graph->search.mark_stamp[node] != graph->search.epoch)
+	{
+		graph->search.mark_stamp[node] = graph->search.epoch;
+		graph->search.touched[graph->search.touched_count++] = node;
+	}
+}
+
+// start and end are never stamped, so they are never "on" the path
+static inline int8_t is_on_path(const t_graph *graph, size_t node)
+{
+	return graph->search.route_stamp[node] == graph->search.epoch;
+}
+
+// ============================================================================
+// PATH SET
+// ============================================================================
+
+static inline size_t path_len(const t_path_set *set, size_t i)
+{
+	return set->offset[i + 1] - set->offset[i];
+}
+
+static inline const uint32_t *path_rooms(const t_path_set *set, size_t i)
+{
+	return set->rooms + set->offset[i];
+}
+
 // ============================================================================
 // FUNCTION PROTOTYPES
 // ============================================================================
@@ -193,24 +420,33 @@ typedef struct
 lem_in_parser_t *parser_create(void);
 void *parser_destroy(lem_in_parser_t *parser);
 bool parse_input(lem_in_parser_t *parser);
+bool parse_chunk(lem_in_parser_t *parser, bool final);
 
 // Input handling
 bool read_input(lem_in_parser_t *parser);
 
 // Validation functions
 bool validate_ant_count(const char *line, int32_t *count, error_code_t *error);
-bool validate_room_name(const char *name, error_code_t *error);
-bool validate_coordinates(const char *x_str, const char *y_str, error_code_t *error);
+bool validate_room_name(const char *name, size_t len, error_code_t *error);
+bool validate_coordinates(const char *x_str, const char *x_end, const char *y_str, const char *y_end,
+	error_code_t *error);
 
 // Parsing functions
-bool parse_room_line(lem_in_parser_t *parser, char *line, int next_flag);
-bool parse_link_line(lem_in_parser_t *parser, char *line);
-bool is_room_line(const char *line);
+bool parse_room_line(lem_in_parser_t *parser, char *line, const line_scan_t *scan, int next_flag);
+bool parse_link_line(lem_in_parser_t *parser, char *line, const line_scan_t *scan);
+bool is_room_line(const char *line, const line_scan_t *scan);
+
+// Line scanner
+void scan_line(char *line, char *end, line_scan_t *scan);
+bool scan_is_room_shape(const char *line, const line_scan_t *scan);
 
 // Hash table
-uint32_t hash_string(const char *str);
-bool hash_add_room(lem_in_parser_t *parser, const char *name, uint16_t room_id);
-int16_t hash_get_room_id(const lem_in_parser_t *parser, const char *name);
+uint32_t hash_string(const char *str, size_t len);
+bool hash_reserve(lem_in_parser_t *parser, size_t count);
+hash_entry_t *hash_find_slot(const lem_in_parser_t *parser, const char *name, size_t len, uint32_t hash);
+void hash_add_room(lem_in_parser_t *parser, hash_entry_t *slot, const char *name, size_t len, uint32_t hash,
+	uint32_t room_id);
+uint32_t hash_get_room_id(const lem_in_parser_t *parser, const char *name, size_t len);
 
 // Error handling
 bool print_error(error_code_t code, const char *context);
@@ -220,17 +456,34 @@ const char *error_to_string(error_code_t code);
 bool display_input(const lem_in_parser_t *parser);
 
 // graph building functions
-t_graph *graph_builder(const lem_in_parser_t *parser);
-t_graph *create_graph(const lem_in_parser_t *parser);
-int8_t create_edge(t_graph *graph, size_t src, size_t dest);
+t_graph *graph_builder(lem_in_parser_t *parser, t_stats *stats);
+t_graph *create_graph(lem_in_parser_t *parser, t_stats *stats);
+size_t find_edge(t_graph *graph, size_t src, size_t dest);
+int8_t prune_dead_ends(t_graph *graph);
+int8_t find_corridors(t_graph *graph);
 
 // cleaner functions
 void free_graph(t_graph *graph);
-void free_bfs(t_bfs *bfs);
-void del_content(void *content);
-t_paths *free_paths(t_paths *paths, t_graph *graph);
+
+// arena functions
+void arena_init(t_arena *arena);
+void *arena_alloc(t_arena *arena, size_t size);
+void *arena_calloc(t_arena *arena, size_t count, size_t size);
+t_arena_mark arena_mark(const t_arena *arena);
+void arena_rewind(t_arena *arena, t_arena_mark mark);
+void arena_release(t_arena *arena);
+
+// path set functions
+void path_set_init(t_path_set *set);
+void path_set_clear(t_path_set *set);
+int8_t path_set_open(t_path_set *set);
+int8_t path_set_push(t_path_set *set, size_t room);
+void path_set_swap(t_path_set *a, t_path_set *b);
+void path_set_free(t_path_set *set);
+int8_t path_set_is_valid(const t_graph *graph, const t_path_set *set, size_t count);
 
 // bfs functions
+int8_t bfs_workspace_init(t_graph *graph);
 t_bfs *bfs_initializer(t_graph *graph);
 int8_t enqueue(size_t node, size_t neigh, t_graph *graph, t_bfs *bfs);
 size_t dequeue(t_bfs *bfs);
@@ -238,38 +491,71 @@ int8_t direct_start_end(t_graph *graph);
 void reset_marks(t_graph *graph, t_bfs *bfs);
 void reset_marks_fail(t_graph *graph, t_bfs *bfs);
 void update_capacity(t_graph *graph, t_bfs *bfs, int8_t order);
-void capacity_changer(t_graph *graph, t_list *from, t_list *to, int8_t order);
-size_t is_on_path(size_t node, t_list *path, t_graph *graph);
-size_t find_path_index(t_list **path, t_list *aug_paths, t_graph *graph);
-t_list *get_next_path(t_list *path, t_graph *graph);
-t_list *add_node_to_paths(size_t *node, t_list **aug_paths);
-t_list *rebuild_paths(t_graph *graph);
+void capacity_changer(t_graph *graph, size_t from, size_t to, int8_t order);
+void stamp_route(t_graph *graph, const t_path_set *paths, size_t path);
+int8_t rebuild_paths(t_graph *graph, t_path_set *paths);
 int8_t is_valid_path(t_graph *graph);
 
 // paths finder functions
-t_bfs *bfs(t_graph *graph, t_list *path);
+t_bfs *bfs(t_graph *graph, const t_path_set *paths, size_t path);
 int8_t is_source_neighbours(size_t node, t_graph *graph);
-void skip_node(t_bfs *new_bfs, t_edge *neigh, t_graph *graph, t_list *path);
+void skip_node(t_bfs *new_bfs, size_t neigh, t_graph *graph);
 t_bfs *reconstruct_path(t_bfs *new_bfs, t_graph *graph);
-void enqueue_node(t_bfs *new_bfs, t_graph *graph, t_edge *neigh, t_list *path);
-size_t find_path_index(t_list **path, t_list *aug_paths, t_graph *graph);
-t_list *bfs_and_compare(t_graph *graph, t_list *aug_paths, t_list **path);
-t_list *first_bfs(t_graph *graph);
-int8_t is_new_solution_better(t_list *aug_paths, t_graph *graph);
-t_paths *find_solution(t_graph *graph, t_list *aug_paths);
-t_list *find_paths(t_graph *graph);
-int8_t is_solution_found(t_paths *paths, t_graph *graph);
+void enqueue_node(t_bfs *new_bfs, t_graph *graph, size_t neigh);
+int8_t bfs_and_compare(t_graph *graph, t_path_set *paths, t_path_set *candidate, size_t path);
+int8_t first_bfs(t_graph *graph, t_path_set *paths);
+int8_t is_new_solution_better(const t_path_set *paths, t_graph *graph);
+t_paths *find_solution(t_graph *graph, const t_path_set *set);
+int8_t find_paths(t_graph *graph, t_path_set *paths);
+
+// vertex-split paths finder functions
+int8_t split_build(t_split_graph *split, t_graph *graph);
+void split_destroy(t_split_graph *split);
+void split_augment(t_split_graph *split);
+size_t split_flow_lengths(t_split_graph *split, t_graph *graph, size_t *len);
+int8_t split_flow_to_paths(t_split_graph *split, t_graph *graph, t_path_set *paths);
+int8_t find_paths_split(t_graph *graph, t_path_set *paths);
+
+// min-cost flow paths finder functions
+int8_t find_paths_mincost(t_graph *graph, t_path_set *paths);
+
+// search bound functions
+size_t lines_lower_bound(t_graph *graph);
+int8_t keep_searching(t_graph *graph, size_t best_lines);
+
+// portfolio functions
+int8_t find_paths_portfolio(t_graph *graph, t_path_set *paths);
+
+// options
+bool parse_options(int argc, char **argv, t_options *options);
+int8_t search_paths(t_graph *graph, const t_options *options, t_path_set *paths);
 
 // solver functions
-int8_t solver(t_graph *graph, t_list *aug_paths);
-// int8_t reset_availability(t_graph *graph, t_paths *paths, size_t *ants2paths);
-void assign_ants_to_paths(t_graph *graph, t_paths *paths, size_t *tmp);
-void display_lines(t_paths *paths, t_graph *graph);
+int8_t solver(t_graph *graph, const t_path_set *set);
+size_t count_output_lines(size_t *len, size_t count, size_t ants);
+size_t evaluate_output_lines(t_graph *graph, const t_path_set *set);
+void assign_ants_to_paths(t_graph *graph, t_paths *paths);
+int8_t display_lines(t_paths *paths, t_graph *graph);
+
+// stats functions
+void stats_start(t_stats *stats);
+void stats_lap(t_stats *stats, t_stage stage);
+bool stats_report(const t_stats *stats, const t_options *options);
+void budget_start(t_budget *budget, const t_options *options, const t_stats *stats);
+bool budget_exhausted(const t_budget *budget, t_stats *stats);
+
+// output writer functions
+bool writer_init(t_writer *writer, int fd);
+bool writer_flush(t_writer *writer);
+bool writer_destroy(t_writer *writer);
+void writer_char(t_writer *writer, char c);
+void writer_str(t_writer *writer, const char *str, size_t len);
+void writer_number(t_writer *writer, size_t n);
+void writer_move(t_writer *writer, size_t ant, const char *room, size_t room_len);
 
 
 // init functions
-t_paths *init_paths(t_graph *graph, t_list *aug_paths);
-t_paths *init_output(t_graph *graph, t_list *aug_paths);
-void init_lines(t_paths *paths, t_graph *graph);
+t_paths *init_paths(t_graph *graph, const t_path_set *set);
+t_paths *init_output(t_graph *graph, const t_path_set *set);
 
 #endif // LEM_IN_H
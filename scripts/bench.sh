@@ -0,0 +1,178 @@
+#!/bin/bash
+
+# ============================================================================
+# Benchmark script for lem-in
+# Runs every map class several times, reports median / p95 solve time,
+# throughput and peak memory, and compares against a stored baseline
+# ============================================================================
+
+# Colors for display
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+CYAN='\033[0;36m'
+RESET='\033[0m'
+BOLD='\033[1m'
+
+# Paths
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+
+LEMIN="$PROJECT_DIR/lem-in"
+BASELINE="${BENCH_BASELINE:-$SCRIPT_DIR/bench_baseline.txt}"
+
+# Configuration (overridable from the environment or `make bench RUNS=...`)
+RUNS="${BENCH_RUNS:-10}"             # runs per map
+TOLERANCE="${BENCH_TOLERANCE:-30}"   # allowed median slowdown, in percent
+SLACK_MS="${BENCH_SLACK_MS:-1}"      # absolute slack so sub-ms maps are not flaky
+UPDATE="${BENCH_UPDATE:-0}"          # 1: rewrite the baseline instead of comparing
+ARGS="${BENCH_ARGS:-}"               # extra lem-in options, e.g. --engine=heuristic
+
+# Map classes: the generator sets and the slow maps
+MAPS=(
+    "$PROJECT_DIR/resources/all_generated/flow-one"
+    "$PROJECT_DIR/resources/all_generated/flow-ten"
+    "$PROJECT_DIR/resources/all_generated/flow-thousand"
+    "$PROJECT_DIR/resources/all_generated/big"
+    "$PROJECT_DIR/resources/all_generated/big-superposition"
+)
+for map_file in "$PROJECT_DIR"/resources/slow_maps/*; do
+    [ -f "$map_file" ] && MAPS+=("$map_file")
+done
+
+# Counters
+TOTAL_RUNS=0
+TOTAL_MS=0
+REGRESSIONS=0
+
+error() {
+    echo -e "${RED}[ERROR]${RESET} $1" >&2
+}
+
+success() {
+    echo -e "${GREEN}[SUCCESS]${RESET} $1"
+}
+
+info() {
+    echo -e "${BLUE}[INFO]${RESET} $1"
+}
+
+warning() {
+    echo -e "${YELLOW}[WARNING]${RESET} $1"
+}
+
+if [ ! -f "$LEMIN" ]; then
+    error "lem-in not found: $LEMIN"
+    error "Compile first with: make"
+    exit 1
+fi
+
+STATS_FILE=$(mktemp)
+SAMPLES_FILE=$(mktemp)
+NEW_BASELINE=$(mktemp)
+trap 'rm -f "$STATS_FILE" "$SAMPLES_FILE" "$NEW_BASELINE"' EXIT
+
+# Solve time of one run: the sum of the stages reported by --stats, which
+# leaves process start-up and the shell out of the measurement.
+# Prints "<ms> <peak_rss_kb>" or nothing if the run failed.
+run_once() {
+    local map_file=$1
+
+    "$LEMIN" $ARGS --stats="$STATS_FILE" < "$map_file" > /dev/null 2>&1 || return 1
+    awk '
+        {
+            body = $0
+            sub(/.*"stages_ms":\{/, "", body)
+            sub(/\}.*/, "", body)
+            n = split(body, fields, ",")
+            for (i = 1; i <= n; i++) { split(fields[i], kv, ":"); total += kv[2] }
+            match($0, /"peak_rss_kb":[0-9]+/)
+            rss = substr($0, RSTART + 14, RLENGTH - 14)
+        }
+        END { printf "%.3f %d\n", total, rss }' "$STATS_FILE"
+}
+
+# Nearest-rank percentile of the samples in SAMPLES_FILE (one per line)
+percentile() {
+    sort -n "$SAMPLES_FILE" | awk -v p="$1" '
+        { v[NR] = $1 }
+        END { r = int((p * NR + 99) / 100); if (r < 1) r = 1; print v[r] }'
+}
+
+# Baseline median of a map, empty if the map is not in the baseline
+baseline_median() {
+    [ -f "$BASELINE" ] || return 0
+    awk -v m="$1" '$1 == m { print $2 }' "$BASELINE"
+}
+
+info "Benchmarking $LEMIN $ARGS (${RUNS} runs per map)"
+if [ "$UPDATE" != "1" ] && [ ! -f "$BASELINE" ]; then
+    warning "No baseline at $BASELINE, run 'make bench-baseline' to record one"
+fi
+printf "\n${BOLD}%-24s %10s %10s %10s %10s  %s${RESET}\n" "map" "median" "p95" "peak_kb" "baseline" "status"
+
+for map_file in "${MAPS[@]}"; do
+    map_name=$(basename "$map_file")
+    : > "$SAMPLES_FILE"
+    peak=0
+    failed=0
+
+    for ((run = 0; run < RUNS; run++)); do
+        if ! sample=$(run_once "$map_file") || [ -z "$sample" ]; then
+            failed=1
+            break
+        fi
+        set -- $sample
+        echo "$1" >> "$SAMPLES_FILE"
+        [ "$2" -gt "$peak" ] && peak=$2
+        TOTAL_MS=$(awk -v a="$TOTAL_MS" -v b="$1" 'BEGIN { printf "%.3f", a + b }')
+        TOTAL_RUNS=$((TOTAL_RUNS + 1))
+    done
+
+    if [ $failed -eq 1 ]; then
+        printf "%-24s ${RED}lem-in failed on this map${RESET}\n" "$map_name"
+        REGRESSIONS=$((REGRESSIONS + 1))
+        continue
+    fi
+
+    median=$(percentile 50)
+    p95=$(percentile 95)
+    echo "$map_name $median $p95 $peak" >> "$NEW_BASELINE"
+
+    base=$(baseline_median "$map_name")
+    if [ "$UPDATE" = "1" ] || [ -z "$base" ]; then
+        status="${CYAN}recorded${RESET}"
+        base="-"
+    elif awk -v m="$median" -v b="$base" -v t="$TOLERANCE" -v s="$SLACK_MS" \
+            'BEGIN { exit !(m > b * (1 + t / 100) + s) }'; then
+        status="${RED}REGRESSION${RESET}"
+        REGRESSIONS=$((REGRESSIONS + 1))
+    else
+        status="${GREEN}ok${RESET}"
+    fi
+    printf "%-24s %8sms %8sms %10s %8s%s  %b\n" "$map_name" "$median" "$p95" "$peak" \
+        "$base" "$([ "$base" = "-" ] && echo "  " || echo "ms")" "$status"
+done
+
+echo ""
+if awk -v t="$TOTAL_MS" 'BEGIN { exit !(t > 0) }'; then
+    info "Throughput: $(awk -v n="$TOTAL_RUNS" -v t="$TOTAL_MS" \
+        'BEGIN { printf "%.1f", n * 1000 / t }') maps/s over $TOTAL_RUNS runs"
+fi
+
+if [ "$UPDATE" = "1" ]; then
+    {
+        echo "# map median_ms p95_ms peak_rss_kb (written by make bench-baseline)"
+        cat "$NEW_BASELINE"
+    } > "$BASELINE"
+    success "Baseline written to $BASELINE"
+    exit 0
+fi
+
+if [ $REGRESSIONS -gt 0 ]; then
+    error "$REGRESSIONS map(s) slower than baseline by more than ${TOLERANCE}% + ${SLACK_MS}ms"
+    exit 1
+fi
+success "No regression against $BASELINE"
+exit 0
@@ -0,0 +1,132 @@
+#!/usr/bin/awk -f
+
+# ============================================================================
+# Move checker for lem-in output
+# Reads what lem-in printed (the map echo, then one line per turn) and
+# checks every move against the map: each ant moves at most once per turn,
+# only along a link, never out of end, and no two ants share a room other
+# than start and end at the end of a turn. All ants must reach end.
+# Prints "OK <turns>", "ERROR" when lem-in printed nothing or ERROR, or
+# "FAIL turn <n>: <reason>"; the exit status is 0 only for OK and ERROR.
+# ============================================================================
+
+function fail(msg) {
+    printf "FAIL turn %d: %s\n", turn, msg
+    failed = 1
+    exit 1
+}
+
+function is_link_line(line,    dash) {
+    dash = index(line, "-")
+    return dash > 1 && (substr(line, 1, dash - 1) in room) && (substr(line, dash + 1) in room)
+}
+
+function is_move_line(    i) {
+    for (i = 1; i <= NF; i++)
+        if ($i !~ /^L[0-9]+-./)
+            return 0
+    return NF > 1 || !is_link_line($1)
+}
+
+BEGIN {
+    ants = -1
+    turn = 0
+    moving = 0
+}
+
+NR == 1 && /^ERROR/ {
+    print "ERROR"
+    errored = 1
+    exit 0
+}
+
+moving && /^#/ {
+    next
+}
+
+!moving && /^#/ {
+    if ($0 == "##start") next_flag = "start"
+    else if ($0 == "##end") next_flag = "end"
+    next
+}
+
+!moving && ants < 0 {
+    ants = $0 + 0
+    next
+}
+
+!moving && NF == 3 && $2 ~ /^-?[0-9]+$/ && $3 ~ /^-?[0-9]+$/ {
+    room[$1] = 1
+    if (next_flag == "start") start = $1
+    else if (next_flag == "end") end = $1
+    next_flag = ""
+    next
+}
+
+!moving && !is_move_line() {
+    if (NF == 1 && is_link_line($1)) {
+        dash = index($1, "-")
+        a = substr($1, 1, dash - 1)
+        b = substr($1, dash + 1)
+        link[a SUBSEP b] = 1
+        link[b SUBSEP a] = 1
+    }
+    next
+}
+
+{
+    if (!moving) {
+        moving = 1
+        for (i = 1; i <= ants; i++)
+            pos[i] = start
+    }
+    turn++
+    split("", moved)
+    split("", target)
+    for (i = 1; i <= NF; i++) {
+        dash = index($i, "-")
+        ant = substr($i, 2, dash - 2) + 0
+        to = substr($i, dash + 1)
+        if (ant < 1 || ant > ants)
+            fail($i ": no such ant")
+        if (ant in moved)
+            fail($i ": ant moves twice")
+        if (pos[ant] == end)
+            fail($i ": ant already reached end")
+        if (!((pos[ant] SUBSEP to) in link))
+            fail($i ": no link from " pos[ant])
+        moved[ant] = 1
+        target[ant] = to
+    }
+    for (ant in target)
+        if (pos[ant] != start && occupant[pos[ant]] == ant)
+            delete occupant[pos[ant]]
+    for (ant in target) {
+        to = target[ant]
+        pos[ant] = to
+        if (to == start || to == end)
+            continue
+        if (to in occupant)
+            fail("L" ant "-" to ": room taken by ant " occupant[to])
+        occupant[to] = ant
+    }
+}
+
+END {
+    if (failed || errored)
+        exit failed
+    if (NR == 0) {
+        print "ERROR"
+        exit 0
+    }
+    if (ants < 0 || start == "" || end == "") {
+        print "FAIL: no map in the output"
+        exit 1
+    }
+    for (i = 1; i <= ants; i++)
+        if (pos[i] != end) {
+            printf "FAIL: ant %d ends in %s after %d turns\n", i, pos[i] == "" ? start : pos[i], turn
+            exit 1
+        }
+    printf "OK %d\n", turn
+}
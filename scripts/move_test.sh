@@ -0,0 +1,142 @@
+#!/bin/bash
+
+# ============================================================================
+# Move validity test for lem-in
+# Runs every engine on the resource maps and on maps from the generator,
+# and checks each printed move with check_moves.awk. The turn count does
+# not matter here, only that the moves are legal and every ant arrives.
+#
+# Usage: bash scripts/move_test.sh [engine...]
+#   MOVE_TEST_SEEDS  generator seeds per style (default: 3)
+#   MOVE_TEST_TIMEOUT  seconds allowed per run (default: 60)
+# ============================================================================
+
+# Colors for display
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+RESET='\033[0m'
+BOLD='\033[1m'
+
+# Paths
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+LEMIN="$PROJECT_DIR/lem-in"
+GENERATOR="$PROJECT_DIR/generator/generator"
+CHECKER="$SCRIPT_DIR/check_moves.awk"
+
+ENGINES=("$@")
+if [ ${#ENGINES[@]} -eq 0 ]; then
+    ENGINES=(split heuristic mincost portfolio)
+fi
+
+RESOURCE_DIRS=(
+    "resources/valid_maps"
+    "resources/particular_case_maps"
+    "resources/visualizer_maps"
+    "resources/all_generated"
+)
+
+MAP_STYLES=(
+    "flow-one"
+    "flow-ten"
+    "flow-thousand"
+    "big"
+    "big-superposition"
+    "snail"
+    "grid"
+    "bipartite"
+)
+
+SEEDS=${MOVE_TEST_SEEDS:-3}
+TIMEOUT=${MOVE_TEST_TIMEOUT:-60}
+
+# Counters
+TOTAL_RUNS=0
+FAILED_RUNS=0
+
+error() {
+    echo -e "${RED}[ERROR]${RESET} $1" >&2
+}
+
+info() {
+    echo -e "${BLUE}[INFO]${RESET} $1"
+}
+
+if [ ! -x "$LEMIN" ]; then
+    error "lem-in not found: $LEMIN"
+    error "Compile first with: make"
+    exit 1
+fi
+
+if [ ! -x "$GENERATOR" ]; then
+    error "Generator not found: $GENERATOR"
+    error "Compile first with: make generator"
+    exit 1
+fi
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+# Collect the maps: resource maps as they are, generated ones in TMP_DIR
+MAPS=()
+for dir in "${RESOURCE_DIRS[@]}"; do
+    for map in "$PROJECT_DIR/$dir"/*; do
+        [ -f "$map" ] && MAPS+=("$map")
+    done
+done
+for style in "${MAP_STYLES[@]}"; do
+    for seed in $(seq 1 "$SEEDS"); do
+        map="$TMP_DIR/${style}_seed${seed}"
+        if ! "$GENERATOR" --style="$style" --seed="$seed" > "$map" 2>/dev/null; then
+            error "Generation failed: ${style} seed ${seed}"
+            exit 1
+        fi
+        MAPS+=("$map")
+    done
+done
+
+info "Checking ${#MAPS[@]} maps with engines: ${ENGINES[*]}"
+
+# Run one engine on one map and check its moves
+check_run() {
+    local engine=$1
+    local map=$2
+    local name=${map#"$PROJECT_DIR/"}
+    local result
+
+    name=${name#"$TMP_DIR/"}
+    result=$(timeout "$TIMEOUT" "$LEMIN" --engine="$engine" < "$map" 2>/dev/null | awk -f "$CHECKER")
+    if [ "${PIPESTATUS[0]}" = "124" ]; then
+        result="FAIL: timed out after ${TIMEOUT}s"
+    fi
+    TOTAL_RUNS=$((TOTAL_RUNS + 1))
+    case "$result" in
+        OK*|ERROR)
+            ;;
+        *)
+            FAILED_RUNS=$((FAILED_RUNS + 1))
+            echo -e "${RED}FAIL${RESET}    ${engine} ${name:0:50} -> ${result}"
+            ;;
+    esac
+}
+
+for engine in "${ENGINES[@]}"; do
+    before=$FAILED_RUNS
+    for map in "${MAPS[@]}"; do
+        check_run "$engine" "$map"
+    done
+    if [ "$FAILED_RUNS" -eq "$before" ]; then
+        echo -e "${GREEN}PASS${RESET}    ${engine}: every move is legal on ${#MAPS[@]} maps"
+    fi
+done
+
+echo ""
+echo -e "${BOLD}Runs:${RESET} ${TOTAL_RUNS}"
+if [ "$FAILED_RUNS" -eq 0 ]; then
+    echo -e "${GREEN}${BOLD}ALL MOVES VALID${RESET}"
+    exit 0
+fi
+echo -e "${YELLOW}${BOLD}Failed:${RESET} ${FAILED_RUNS}"
+exit 1
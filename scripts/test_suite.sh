@@ -150,6 +150,28 @@ run_file_test() {
 	fi
 }
 
+# Pipe the input followed by many more lines and check that lem-in reads
+# them all: the writer must not die of SIGPIPE once parsing has stopped.
+run_pipe_test() {
+	local test_name="$1"
+	local input="$2"
+	local writer_status
+
+	TOTAL_TESTS=$((TOTAL_TESTS + 1))
+	printf "%-40s " "$test_name:"
+
+	{ printf "%b\n" "$input"; yes "trailing line" | head -n 200000; } | timeout $TIMEOUT $BINARY >/dev/null 2>&1
+	writer_status=${PIPESTATUS[0]}
+
+	if [ "$writer_status" -eq 0 ]; then
+		printf "${GREEN}[PASS]${RESET}\n"
+		PASSED_TESTS=$((PASSED_TESTS + 1))
+	else
+		printf "${RED}[FAIL] (writer exited with %s)${RESET}\n" "$writer_status"
+		FAILED_TESTS=$((FAILED_TESTS + 1))
+	fi
+}
+
 # ============================================================================
 # TEST SUITES
 # ============================================================================
@@ -223,6 +245,13 @@ test_edge_cases() {
 	run_test "Complex valid graph" "5\n##start\nstart 0 0\na 1 0\nb 2 0\nc 1 1\n##end\nend 2 1\nstart-a\nstart-b\na-c\nb-c\nc-end" true
 }
 
+test_pipe_input() {
+	print_section "Pipe Input"
+
+	run_pipe_test "Lines after the empty line" "2\n##start\nstart 0 0\n##end\nend 1 1\nstart-end\n"
+	run_pipe_test "Lines after an error" "abc"
+}
+
 test_file_suite() {
 	print_section "File-based Tests"
 
@@ -450,5 +479,6 @@ test_advanced_link_validation
 test_advanced_parsing_edge_cases
 test_valid_cases
 test_edge_cases
+test_pipe_input
 test_file_suite
 print_summary
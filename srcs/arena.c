@@ -0,0 +1,114 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                               ARENA
+ *
+ * Allocation par simple increment dans des blocs chaines. Rien n'est
+ * libere individuellement : arena_rewind revient a une marque prise plus
+ * tot (les allocations temporaires d'un bfs par exemple) et arena_release
+ * rend tous les blocs d'un coup. Le plus gros bloc rendu par un rewind est
+ * garde de cote, les bfs successifs n'appellent donc plus malloc.
+ *=========================================================================== */
+
+#define ARENA_ALIGN 16
+
+void arena_init(t_arena *arena)
+{
+    arena->head = NULL;
+    arena->spare = NULL;
+    arena->allocations = 0;
+}
+
+static t_arena_block *new_block(t_arena *arena, size_t size)
+{
+    t_arena_block *block;
+
+    if (size < ARENA_BLOCK_SIZE)
+        size = ARENA_BLOCK_SIZE;
+    if (arena->spare && arena->spare->size >= size)
+    {
+        block = arena->spare;
+        arena->spare = NULL;
+    }
+    else if (!(block = malloc(sizeof(t_arena_block) + size)))
+        return NULL;
+    else
+    {
+        block->size = size;
+        arena->allocations++;
+    }
+    block->used = 0;
+    block->next = arena->head;
+    arena->head = block;
+    return block;
+}
+
+void *arena_alloc(t_arena *arena, size_t size)
+{
+    t_arena_block *block = arena->head;
+    size_t offset;
+
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (!block || block->size - block->used < size)
+    {
+        if (!(block = new_block(arena, size)))
+            return NULL;
+    }
+    offset = block->used;
+    block->used += size;
+    return block->data + offset;
+}
+
+void *arena_calloc(t_arena *arena, size_t count, size_t size)
+{
+    void *ptr;
+
+    if (size && count > SIZE_MAX / size)
+        return NULL;
+    if ((ptr = arena_alloc(arena, count * size)))
+        ft_bzero(ptr, count * size);
+    return ptr;
+}
+
+t_arena_mark arena_mark(const t_arena *arena)
+{
+    t_arena_mark mark;
+
+    mark.block = arena->head;
+    mark.used = arena->head ? arena->head->used : 0;
+    return mark;
+}
+
+// oublier tout ce qui a ete alloue depuis la marque
+void arena_rewind(t_arena *arena, t_arena_mark mark)
+{
+    t_arena_block *block;
+
+    while (arena->head != mark.block)
+    {
+        block = arena->head;
+        arena->head = block->next;
+        if (!arena->spare || arena->spare->size < block->size)
+        {
+            free(arena->spare);
+            arena->spare = block;
+        }
+        else
+            free(block);
+    }
+    if (arena->head)
+        arena->head->used = mark.used;
+}
+
+void arena_release(t_arena *arena)
+{
+    t_arena_block *block;
+
+    while ((block = arena->head))
+    {
+        arena->head = block->next;
+        free(block);
+    }
+    free(arena->spare);
+    arena_init(arena);
+}
@@ -10,100 +10,67 @@
 /*---------------------------------------------------------------------------
  *                               paths building utilities
  *--------------------------------------------------------------------------- */
- 
- //ajouter un noeud sur un chemin (a la fin de la liste chainee des chemins)
- t_list *add_node_to_paths(size_t *node, t_list **aug_paths)
- {
-     t_list *tmp;
-     size_t *dup;
- 
-     dup = malloc(sizeof(size_t));
-     if (!dup)
-         return NULL;
-     *dup = *node;
-     if (!(tmp = ft_lstnew(dup)))
-     {
-         free(dup);
-         return NULL;
-     }
-     ft_lstappend(aug_paths, tmp);
-     return tmp;
- }
 
 //Reconstruire les chemins en suivant les noeuds ayant une capacite de 0
-t_list *rebuild_paths(t_graph *graph)
+int8_t rebuild_paths(t_graph *graph, t_path_set *paths)
 {
-    t_list *aug_paths;
-    t_edge *neighbours;
+    size_t start = graph->start_room_id;
+    size_t node;
+    size_t e;
 
-    aug_paths = NULL;
-    for (t_edge *from_start_edge = graph->nodes[graph->start_room_id].head; from_start_edge != NULL; from_start_edge = from_start_edge->next)
+    path_set_clear(paths);
+    for (size_t from_start = graph->edge_offset[start]; from_start < graph->edge_offset[start + 1]; from_start++)
     {
-        if (from_start_edge->capacity == 0)
+        if (graph->edge_capacity[from_start] == 0)
         {
-            if (add_node_to_paths(&graph->start_room_id, &aug_paths) == NULL)
-                return NULL;
-             if (add_node_to_paths(&from_start_edge->dest, &aug_paths) == NULL)
-                return NULL;
-            neighbours = graph->nodes[from_start_edge->dest].head;
-            while (neighbours != NULL && neighbours->dest != graph->end_room_id)
+            node = graph->edge_dest[from_start];
+            if (path_set_open(paths) == FAILURE
+                || path_set_push(paths, start) == FAILURE
+                || path_set_push(paths, node) == FAILURE)
+                return FAILURE;
+            e = graph->edge_offset[node];
+            while (e < graph->edge_offset[node + 1] && graph->edge_dest[e] != graph->end_room_id)
             {
-                if (neighbours->capacity == 0)
+                if (graph->edge_capacity[e] == 0)
                 {
-                    if (add_node_to_paths(&neighbours->dest, &aug_paths) == NULL)
-                        return (NULL);
-                    neighbours = graph->nodes[neighbours->dest].head;
+                    node = graph->edge_dest[e];
+                    if (path_set_push(paths, node) == FAILURE)
+                        return FAILURE;
+                    e = graph->edge_offset[node];
                 }
                 else
-                    neighbours = neighbours->next;
-                if (neighbours->dest == graph->end_room_id
-                    && neighbours->capacity == 0
-                    && add_node_to_paths(&neighbours->dest, &aug_paths) == NULL)
-                    return (NULL);
+                    e++;
+                if (e < graph->edge_offset[node + 1]
+                    && graph->edge_dest[e] == graph->end_room_id
+                    && graph->edge_capacity[e] == 0
+                    && path_set_push(paths, graph->end_room_id) == FAILURE)
+                    return FAILURE;
             }
         }
     }
-    return aug_paths;
+    return SUCCESS;
 }
 
  /*---------------------------------------------------------------------------
  *                               helper functions
  *--------------------------------------------------------------------------- */
- 
-
- //verifier si un noeud est sur un chemin
- size_t is_on_path(size_t node, t_list *path, t_graph *graph)
- {
-    for (t_list *curr = path; curr != NULL && *(size_t *)curr->content != graph->end_room_id; curr = curr->next)
-    {
-        if (*(size_t *)curr->content == node && node != graph->start_room_id && node != graph->end_room_id)
-            return TRUE;
-    }
-    return FALSE;
-}
 
-// trouver l'index d'un chemin dans la liste des chemins
-size_t find_path_index(t_list **path, t_list *aug_paths, t_graph *graph)
+// marquer les salles du chemin que le bfs contourne, pour que is_on_path
+// reponde en O(1). comme l'ancien parcours de liste, on avance depuis le
+// debut du chemin jusqu'a la premiere salle end rencontree
+void stamp_route(t_graph *graph, const t_path_set *paths, size_t path)
 {
-    size_t path_index = 0;
-    
-    for (t_list *curr = aug_paths; curr != *path && curr->next != NULL; curr = curr->next)
+    size_t end = paths->offset[paths->count];
+    uint32_t room;
+
+    for (size_t k = paths->offset[path]; k < end; k++)
     {
-        if (*(size_t *)curr->content == graph->start_room_id)
-            path_index++;
+        room = paths->rooms[k];
+        if (room == graph->end_room_id)
+            break;
+        if (room != graph->start_room_id)
+            graph->search.route_stamp[room] = graph->search.epoch;
     }
-    return path_index;
-}
-
-// trouver le prochain chemin dans la liste des chemins
-t_list *get_next_path(t_list *path, t_graph *graph)
-{
-    t_list *next_path = path;
-
-    while (next_path->next != NULL && *(size_t *)next_path->next->content != graph->start_room_id)
-        next_path = next_path->next;
-    next_path = next_path->next;
-    return next_path;
 }
 
  /*---------------------------------------------------------------------------
@@ -111,38 +78,27 @@ t_list *get_next_path(t_list *path, t_graph *graph)
  *--------------------------------------------------------------------------- */
 
  //fonction helper pour update_capacity() juste en dessous
-void capacity_changer(t_graph *graph, t_list *from, t_list *to, int8_t order)
+ //le passage inverse est retrouve directement par son index jumeau
+void capacity_changer(t_graph *graph, size_t from, size_t to, int8_t order)
 {
-    t_edge *neighbours;
-    neighbours = graph->nodes[*(size_t *)from->content].head;
-
-    while (neighbours->dest != *(size_t *)to->content)
-        neighbours = neighbours->next;
+    size_t e;
 
-    if (neighbours->dest == *(size_t *)to->content)
-    {
-        if (order == INCREASE)
-            neighbours->capacity++;
-        if (order == DECREASE)
-            neighbours->capacity--;
-    }
+    e = find_edge(graph, from, to);
+    if (e == graph->edge_count)
+        return;
+    graph->edge_capacity[e] += order;
+    graph->edge_capacity[graph->edge_twin[e]] -= order;
 }
 
 // changer la capacite des passages d'un chemin
 void update_capacity(t_graph *graph, t_bfs *bfs, int8_t order)
 {
-    for (t_list *curr = bfs->shortest_path; curr->next != NULL; curr = curr->next)
+    for (size_t k = 0; k + 1 < bfs->path_len; k++)
     {
         if (order == INCREASE)
-        {
-            capacity_changer(graph, curr, curr->next, DECREASE);
-            capacity_changer(graph, curr->next, curr, INCREASE);
-        }
+            capacity_changer(graph, bfs->path[k], bfs->path[k + 1], DECREASE);
         else if (order == DECREASE)
-        {
-            capacity_changer(graph, curr, curr->next, INCREASE);
-            capacity_changer(graph, curr->next, curr, DECREASE);
-        }
+            capacity_changer(graph, bfs->path[k], bfs->path[k + 1], INCREASE);
     }
     graph->paths_count += order;
 }
@@ -154,14 +110,10 @@ void update_capacity(t_graph *graph, t_bfs *bfs, int8_t order)
 // verifier si un noeud a un passage avec une capacite de 2
 static int8_t find_neighbour(t_graph *graph, size_t i, int8_t found)
 {
-    t_edge *neighbours;
-
-    neighbours = graph->nodes[i].head;
-    while (neighbours)
+    for (size_t e = graph->edge_offset[i]; e < graph->edge_offset[i + 1]; e++)
     {
-        if (neighbours->capacity == 2)
+        if (graph->edge_capacity[e] == 2)
             return TRUE;
-        neighbours = neighbours->next;
     }
     return found;
 }
@@ -169,59 +121,105 @@ static int8_t find_neighbour(t_graph *graph, size_t i, int8_t found)
 // verifier si le debut et la fin sont directement connectes
 int8_t direct_start_end(t_graph *graph)
 {
-    t_edge *curr;
+    size_t start = graph->start_room_id;
 
-    curr = graph->nodes[graph->start_room_id].head;
-    while (curr)
+    for (size_t e = graph->edge_offset[start]; e < graph->edge_offset[start + 1]; e++)
     {
-        if (curr->dest == graph->end_room_id)
+        if (graph->edge_dest[e] == graph->end_room_id)
             return TRUE;
-        curr = curr->next;
     }
     return FALSE;
 }
 
-// remettre les marques des noeuds
-void reset_marks(t_graph *graph, t_bfs *bfs)
+// passer a l'epoque suivante : toutes les marques non reportees tombent
+static void next_epoch(t_graph *graph)
+{
+    if (++graph->search.epoch == 0)
+    {
+        ft_bzero(graph->search.mark_stamp, graph->size * sizeof(uint32_t));
+        ft_bzero(graph->search.enqueue_stamp, graph->size * sizeof(uint32_t));
+        ft_bzero(graph->search.path_stamp, graph->size * sizeof(uint32_t));
+        ft_bzero(graph->search.route_stamp, graph->size * sizeof(uint32_t));
+        graph->search.epoch = 1;
+    }
+}
+
+// ramener l'epoque courante a 1 en gardant ses marques : sans ca epoch + 1
+// vaudrait 0 et next_epoch effacerait les marques qu'on vient de reporter
+static void rebase_stamps(t_graph *graph)
 {
-    int8_t found;
-    t_list *curr;
+    uint32_t epoch = graph->search.epoch;
 
     for (size_t i = 0; i < graph->size; i++)
     {
-        found = FALSE;
-        curr = bfs->shortest_path;
-        while (curr)
-        {
-            if (i == *(size_t *)curr->content)
-                found = TRUE;
-            curr = curr->next;
-        }
-        found = find_neighbour(graph, i, found);
-        if (found == FALSE || \
-            (((graph->nodes[i].flags & ROOM_START) || (graph->nodes[i].flags & ROOM_END)) && direct_start_end(graph) == FALSE))
-            graph->nodes[i].bfs_marked = FALSE;
-            
-        graph->nodes[i].enqueued = FALSE;
-        graph->nodes[i].enqueued_backward = FALSE;
+        graph->search.mark_stamp[i] = graph->search.mark_stamp[i] == epoch;
+        graph->search.enqueue_stamp[i] = graph->search.enqueue_stamp[i] == epoch;
+        graph->search.path_stamp[i] = graph->search.path_stamp[i] == epoch;
+        graph->search.route_stamp[i] = graph->search.route_stamp[i] == epoch;
     }
+    graph->search.epoch = 1;
 }
 
-// remettre les marques des noeuds en cas de fail (donc on ne touche pas a ceux appartenant a un autre chemin)
-void reset_marks_fail(t_graph *graph, t_bfs *bfs)
+// reporter sur l'epoque suivante les marques de list[] qui satisfont keep.
+// seuls les noeuds marques par ce bfs ou deja reportes peuvent l'etre,
+// le reste du graphe n'est jamais parcouru
+static size_t carry_marks(t_graph *graph, uint32_t *list, size_t count, size_t kept,
+    int8_t direct)
 {
-    for (size_t i = 0; i < graph->size; i++)
+    uint32_t epoch;
+    uint32_t i;
+
+    if (graph->search.epoch == UINT32_MAX)
+        rebase_stamps(graph);
+    epoch = graph->search.epoch;
+    for (size_t j = 0; j < count; j++)
     {
-        for (ssize_t j = 0; bfs->queue[j] != -1; j++)
+        i = list[j];
+        if (graph->search.mark_stamp[i] != epoch)
+            continue;
+        if (direct != -1)
         {
-            if (i == (size_t)bfs->queue[j])
-                graph->nodes[i].bfs_marked = FALSE;
+            if (graph->search.path_stamp[i] != epoch && find_neighbour(graph, i, FALSE) == FALSE)
+                continue;
+            if ((graph->nodes[i].flags & (ROOM_START | ROOM_END)) && direct == FALSE)
+                continue;
         }
-        graph->nodes[i].enqueued = FALSE;
-        graph->nodes[i].enqueued_backward = FALSE;
+        graph->search.mark_stamp[i] = epoch + 1;
+        graph->search.kept[kept++] = i;
     }
+    return kept;
+}
+
+// remettre les marques des noeuds : un noeud reste marque s'il est sur le
+// nouveau chemin ou sur un chemin existant (passage de capacite 2)
+void reset_marks(t_graph *graph, t_bfs *bfs)
+{
+    int8_t direct = direct_start_end(graph);
+    size_t kept;
+
+    for (size_t k = 0; k < bfs->path_len; k++)
+        graph->search.path_stamp[bfs->path[k]] = graph->search.epoch;
+    kept = carry_marks(graph, graph->search.kept, graph->search.kept_count, 0, direct);
+    kept = carry_marks(graph, graph->search.touched, graph->search.touched_count, kept, direct);
+    graph->search.kept_count = kept;
+    graph->search.touched_count = 0;
+    next_epoch(graph);
+}
+
+// remettre les marques des noeuds en cas de fail (donc on ne touche pas a ceux appartenant a un autre chemin)
+void reset_marks_fail(t_graph *graph, t_bfs *bfs)
+{
+    size_t kept;
+
+    for (size_t j = 0; j <= bfs->queue_rear; j++)
+        graph->search.mark_stamp[bfs->queue[j]] = 0;
+    kept = carry_marks(graph, graph->search.kept, graph->search.kept_count, 0, -1);
+    kept = carry_marks(graph, graph->search.touched, graph->search.touched_count, kept, -1);
+    graph->search.kept_count = kept;
+    graph->search.touched_count = 0;
+    next_epoch(graph);
 }
- 
+
  /*---------------------------------------------------------------------------
  *                               queue utilities
  *--------------------------------------------------------------------------- */
@@ -237,8 +235,8 @@ int8_t enqueue(size_t node, size_t neigh, t_graph *graph, t_bfs *bfs)
     bfs->queue_size = bfs->queue_size + 1;
 
     bfs->prev[neigh] = node;
-    graph->nodes[neigh].bfs_marked = TRUE;
-    graph->nodes[neigh].enqueued = TRUE;
+    mark_node(graph, neigh);
+    graph->search.enqueue_stamp[neigh] = graph->search.epoch;
 
     return SUCCESS;
 }
@@ -262,45 +260,49 @@ size_t dequeue(t_bfs *bfs)
  *                               BFS INITIALIZER
  *--------------------------------------------------------------------------- */
 
- // initialiser la structure de bfs
-t_bfs *bfs_initializer(t_graph *graph)
+ // allouer l'espace de recherche une seule fois, avec le graph
+int8_t bfs_workspace_init(t_graph *graph)
 {
-    t_bfs *bfs;
+    t_bfs *ws = &graph->search;
+    t_arena *arena = &graph->arena;
+    size_t size = graph->size;
+
+    ws->epoch = 1;
+    ws->kept_count = 0;
+    ws->touched_count = 0;
+    ws->path_len = 0;
+    ws->queue_capacity = size * 2;
+    ws->mark_stamp = arena_calloc(arena, size, sizeof(uint32_t));
+    ws->enqueue_stamp = arena_calloc(arena, size, sizeof(uint32_t));
+    ws->path_stamp = arena_calloc(arena, size, sizeof(uint32_t));
+    ws->route_stamp = arena_calloc(arena, size, sizeof(uint32_t));
+    ws->kept = arena_alloc(arena, size * sizeof(uint32_t));
+    ws->touched = arena_alloc(arena, size * sizeof(uint32_t));
+    ws->path = arena_alloc(arena, size * sizeof(uint32_t));
+    ws->queue = arena_alloc(arena, ws->queue_capacity * sizeof(ssize_t));
+    ws->prev = arena_alloc(arena, size * sizeof(ssize_t));
+    if (!ws->mark_stamp || !ws->enqueue_stamp || !ws->path_stamp || !ws->route_stamp
+        || !ws->kept || !ws->touched || !ws->path || !ws->queue || !ws->prev)
+        return FAILURE;
+    return SUCCESS;
+}
 
-    if (!(bfs = (t_bfs*)malloc(sizeof(t_bfs))))
-        return NULL;
+ // preparer l'espace de recherche pour un nouveau bfs : rien a effacer,
+ // prev n'est lu que pour les noeuds atteints pendant l'epoque courante
+t_bfs *bfs_initializer(t_graph *graph)
+{
+    t_bfs *bfs = &graph->search;
+    size_t start = graph->start_room_id;
 
     bfs->queue_front = 0;
-    bfs->queue_size = 0;
     bfs->queue_rear = 0;
     bfs->node = 0;
-    bfs->shortest_path = NULL;
-    bfs->queue_capacity = graph->size * 2;
-
-    if (!(bfs->queue = malloc(bfs->queue_capacity * sizeof(ssize_t))))
-    {
-        free(bfs);
-        return NULL;
-    }
-    if ((bfs->prev = (ssize_t*)malloc(graph->size * sizeof(ssize_t))) == NULL)
-    {
-        free(bfs->queue);
-        free(bfs);
-        return NULL;
-    }
-    for (size_t i = 0; i < graph->size; i++)
-    {
-        bfs->prev[i] = -1;
-        bfs->queue[i] = -1;
-        if (graph->nodes[i].flags & ROOM_START)
-        {
-            bfs->queue[0] = i;
-            bfs->queue_size = 1;
-            graph->nodes[i].bfs_marked = TRUE;
-            graph->nodes[i].enqueued = TRUE;
-            graph->nodes[i].enqueued_backward = TRUE;
-        }
-    }
+    bfs->path_len = 0;
+    bfs->queue[0] = start;
+    bfs->queue_size = 1;
+    bfs->prev[start] = -1;
+    mark_node(graph, start);
+    graph->search.enqueue_stamp[start] = graph->search.epoch;
     return bfs;
 }
 
@@ -313,18 +315,13 @@ int8_t is_valid_path(t_graph *graph)
 {
     t_bfs *result;
 
-    result = bfs(graph, NULL);
+    result = bfs(graph, NULL, 0);
     if (result == NULL)
         return FALSE;
-    ft_lstclear(&result->shortest_path, del_content);
-    free_bfs(result);
     
     // Nettoyer TOUTES les marques pour ne pas affecter les appels suivants
-    for (size_t i = 0; i < graph->size; i++)
-    {
-        graph->nodes[i].bfs_marked = FALSE;
-        graph->nodes[i].enqueued = FALSE;
-        graph->nodes[i].enqueued_backward = FALSE;
-    }
+    graph->search.kept_count = 0;
+    graph->search.touched_count = 0;
+    next_epoch(graph);
     return TRUE;
 }
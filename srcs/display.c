@@ -1,77 +1,117 @@
 #include "lem_in.h"
 
-static void	display_first_move(t_list **ants_positions, t_paths *paths,
-	t_graph *graph, size_t i, int *first)
+// fourmi en vol : son numero, son chemin et son rang sur ce chemin
+// (0 sur start, len une fois arrivee sur end)
+typedef struct s_flight
 {
-	if (paths->available[paths->ants_to_paths[i]] == TRUE)
+	size_t		ant;
+	uint32_t	path;
+	uint32_t	pos;
+}	t_flight;
+
+static inline void display_move(t_writer *out, t_graph *graph, size_t ant, size_t room_id, int *first)
+{
+	t_node *room = &graph->nodes[room_id];
+
+	if (!*first)
+		writer_char(out, ' ');
+	writer_move(out, ant + 1, graph->input + room->name_offset, room->name_len);
+	*first = 0;
+}
+
+// un chemin start-end direct ne donne qu'un tour : toutes les fourmis
+// arrivent ensemble. dans ce cas count_output_lines vaut 1 et aucun autre
+// chemin ne recoit de fourmi
+static int8_t display_direct(t_paths *paths, t_graph *graph, t_writer *out)
+{
+	int first = 1;
+
+	for (size_t p = 0; p < graph->paths_count; p++)
 	{
-		if (ants_positions[i] != NULL)
-			ants_positions[i] = ants_positions[i]->next;
-		if (ants_positions[i] != NULL && ants_positions[i]->next != NULL)
-			paths->available[paths->ants_to_paths[i]] = FALSE;
-		paths->n[paths->ants_to_paths[i]]--;
-		if (ants_positions[i] != NULL)
+		if (path_len(paths->set, p) == 2 && paths->n[p] > 0)
 		{
-			if (!*first)
-				ft_printf(" ");
-			ft_printf("L%zu-%s", i + 1,
-				graph->nodes[*(size_t *)ants_positions[i]->content].name);
-			*first = 0;
+			for (size_t ant = 0; ant < graph->ants; ant++)
+				display_move(out, graph, ant, graph->end_room_id, &first);
+			writer_char(out, '\n');
+			return TRUE;
 		}
 	}
+	return FALSE;
 }
 
-static void display_moves(t_list **ants_positions, t_paths *paths, t_graph *graph, size_t i, int *first)
+// au tour t part le round t - 1 du planning : une fourmi par chemin qui
+// n'a pas encore envoye ses n[p] fourmis, dans l'ordre des chemins. les
+// numeros suivent donc ceux deja en vol et la fenetre reste triee
+static size_t launch_round(t_paths *paths, t_flight *flight, size_t count,
+	size_t *active, size_t *active_count, size_t turn, size_t *next_ant)
 {
-	if (ants_positions[i] == paths->array[paths->ants_to_paths[i]]->next && paths->n[paths->ants_to_paths[i]] > 0)
-		paths->available[paths->ants_to_paths[i]] = TRUE;
-	if (ants_positions[i] != NULL)
-		ants_positions[i] = ants_positions[i]->next;
-	if (ants_positions[i] != NULL)
+	size_t kept = 0;
+
+	for (size_t k = 0; k < *active_count; k++)
 	{
-		if (!*first)
-			ft_printf(" ");
-		ft_printf("L%zu-%s", i + 1,
-			graph->nodes[*(size_t *)ants_positions[i]->content].name);
-		*first = 0;
+		flight[count].ant = (*next_ant)++;
+		flight[count].path = active[k];
+		flight[count].pos = 0;
+		count++;
+		if (paths->n[active[k]] > turn)
+			active[kept++] = active[k];
 	}
+	*active_count = kept;
+	return count;
 }
 
-static void display_laps(t_paths *paths, t_graph *graph, t_list **ants_positions)
+// avancer chaque fourmi en vol d'une salle et retirer celles qui arrivent
+static size_t display_turn(t_paths *paths, t_graph *graph, t_flight *flight,
+	size_t count, t_writer *out)
 {
-	size_t	i;
-	int		first;
+	size_t kept = 0;
+	int first = 1;
 
-	first = 1;
-	i = 0;
-	while (i < graph->ants)
+	for (size_t i = 0; i < count; i++)
 	{
-		if (ants_positions[i] == paths->array[paths->ants_to_paths[i]])
-			display_first_move(ants_positions, paths, graph, i, &first);
-		else if (ants_positions[i] != NULL && ants_positions[i]->next != NULL)
-			display_moves(ants_positions, paths, graph, i, &first);
-		else if (ants_positions[i] != NULL && ants_positions[i]->next == NULL)
-			ants_positions[i] = ants_positions[i]->next;
-		i++;
+		t_flight ant = flight[i];
+
+		ant.pos++;
+		display_move(out, graph, ant.ant, path_rooms(paths->set, ant.path)[ant.pos], &first);
+		if (ant.pos + 1 < path_len(paths->set, ant.path))
+			flight[kept++] = ant;
 	}
-	ft_printf("\n");
+	writer_char(out, '\n');
+	return kept;
 }
 
-void display_lines(t_paths *paths, t_graph *graph)
+// simulation par tour : seules les fourmis en vol sont parcourues, la
+// sortie coute O(nombre de mouvements). une fourmi occupe une salle
+// distincte de son chemin, la fenetre tient donc dans le nombre de salles
+int8_t display_lines(t_paths *paths, t_graph *graph)
 {
-	t_list *ants_positions[graph->ants];
-	size_t lap = 0;
+	t_writer out;
+	t_flight *flight;
+	size_t *active;
+	size_t active_count = 0, count = 0, next_ant = 0, turn = 0;
 
-	for (size_t i = 0; i < graph->ants; i++)
+	flight = arena_alloc(&graph->arena, paths->set->offset[paths->set->count] * sizeof(t_flight));
+	active = arena_alloc(&graph->arena, graph->paths_count * sizeof(size_t));
+	if (!flight || (graph->paths_count && !active) || writer_init(&out, STDOUT_FILENO) == false)
+		return FAILURE;
+
+	for (size_t p = 0; p < graph->paths_count; p++)
 	{
-		ants_positions[i] = paths->array[paths->ants_to_paths[i]];
+		if (paths->n[p] > 0)
+			active[active_count++] = p;
 	}
-	while(lap++ < paths->output_lines)
+	if (display_direct(paths, graph, &out) == TRUE)
+		turn = paths->output_lines;
+	while (turn++ < paths->output_lines)
 	{
-		display_laps(paths, graph, ants_positions);
+		count = launch_round(paths, flight, count, active, &active_count, turn, &next_ant);
+		count = display_turn(paths, graph, flight, count, &out);
 	}
 
 	#if DEBUG
-		ft_printf("# Number of lines: %zu\n", paths->output_lines);
+		writer_str(&out, "# Number of lines: ", 19);
+		writer_number(&out, paths->output_lines);
+		writer_char(&out, '\n');
 	#endif
-}
\ No newline at end of file
+	return writer_destroy(&out) ? SUCCESS : FAILURE;
+}
@@ -28,7 +28,9 @@ const char *error_to_string(error_code_t code)
 		[ERR_INVALID_LINE] = "Invalid line format",
 		[ERR_TOO_MANY_ROOMS] = "Too many rooms",
 		[ERR_TOO_MANY_LINKS] = "Too many links",
-		[ERR_NO_PATH] = "No path found"};
+		[ERR_NO_PATH] = "No path found",
+		[ERR_INVALID_OPTION] = "Invalid option",
+		[ERR_STATS_OUTPUT] = "Cannot write stats"};
 
 	if (code >= 0 && code < sizeof(error_messages) / sizeof(error_messages[0]))
 	{
@@ -4,61 +4,89 @@
  *                               GRAPH BUILDER FUNCTIONS
  * ============================================================================ */
 
- //creer un passage entre deux noeuds
-int8_t create_edge(t_graph *graph, size_t src, size_t dest)
+// allouer les tableaux CSR : offsets par noeud, puis pour chaque passage
+// sa destination, l'index du passage inverse et sa capacite residuelle
+static int8_t allocate_edges(t_graph *graph, size_t edge_count)
 {
-    t_edge *forward_edge;
-    t_edge *backward_edge;
-
-    if ((forward_edge = (t_edge*)malloc(sizeof(t_edge))) == NULL)
+    graph->edge_count = 0;
+    graph->edge_offset = arena_calloc(&graph->arena, graph->size + 1, sizeof(uint32_t));
+    graph->edge_dest = arena_alloc(&graph->arena, edge_count * sizeof(uint32_t));
+    graph->edge_twin = arena_alloc(&graph->arena, edge_count * sizeof(uint32_t));
+    graph->edge_capacity = arena_alloc(&graph->arena, edge_count);
+    if (!graph->edge_offset || !graph->edge_dest || !graph->edge_twin || !graph->edge_capacity)
         return FAILURE;
-    forward_edge->capacity = 1;
-    forward_edge->dest = dest;
-    forward_edge->next = graph->nodes[src].head;
-    graph->nodes[src].head = forward_edge;
+    return SUCCESS;
+}
 
-    if ((backward_edge = (t_edge*)malloc(sizeof(t_edge))) == NULL)
-    {
-        free(forward_edge);
+//creer un passage entre deux noeuds dans l'emplacement reserve par build_edges
+static void create_edge(t_graph *graph, uint32_t *cursor, size_t src, size_t dest)
+{
+    uint32_t forward = --cursor[src];
+    uint32_t backward = --cursor[dest];
+
+    graph->edge_dest[forward] = dest;
+    graph->edge_capacity[forward] = 1;
+    graph->edge_twin[forward] = backward;
+    graph->edge_dest[backward] = src;
+    graph->edge_capacity[backward] = 1;
+    graph->edge_twin[backward] = forward;
+}
+
+// remplir le CSR a partir des liens du parser. chaque noeud est rempli
+// depuis la fin de sa plage, ce qui garde l'ordre de l'ancienne liste
+// chainee (dernier lien ajoute en tete) et donc le meme parcours du bfs
+static int8_t build_edges(t_graph *graph, const lem_in_parser_t *parser)
+{
+    uint32_t *cursor;
+    t_arena_mark mark;
+
+    if (allocate_edges(graph, parser->link_count * 2) == FAILURE)
         return FAILURE;
+    for (size_t i = 0; i < parser->link_count; i++)
+    {
+        graph->edge_offset[parser->links[i].from + 1]++;
+        graph->edge_offset[parser->links[i].to + 1]++;
     }
-    backward_edge->capacity = 1;
-    backward_edge->dest = src;
-    backward_edge->next = graph->nodes[dest].head;
-    graph->nodes[dest].head = backward_edge;
-
+    for (size_t i = 0; i < graph->size; i++)
+        graph->edge_offset[i + 1] += graph->edge_offset[i];
+    mark = arena_mark(&graph->arena);
+    if ((cursor = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t))) == NULL)
+        return FAILURE;
+    for (size_t i = 0; i < graph->size; i++)
+        cursor[i] = graph->edge_offset[i + 1];
+    for (size_t i = 0; i < parser->link_count; i++)
+        create_edge(graph, cursor, parser->links[i].from, parser->links[i].to);
+    arena_rewind(&graph->arena, mark);
+    graph->edge_count = parser->link_count * 2;
     return SUCCESS;
 }
 
-// initialiser les valeurs du graph grace a celles recuperee dans le parser
-static t_graph *graph_initializer(const lem_in_parser_t *parser, t_graph *graph)
+// trouver le passage src -> dest (le premier dans l'ordre de parcours)
+size_t find_edge(t_graph *graph, size_t src, size_t dest)
 {
-    for (size_t i = 0; i < graph->size; i++)
+    for (size_t e = graph->edge_offset[src]; e < graph->edge_offset[src + 1]; e++)
     {
-        graph->nodes[i].index = parser->rooms[i].id;
-        if (!(graph->nodes[i].name = ft_strdup(parser->rooms[i].name)))
-        {
-            for (size_t j = 0; j < i; j++)
-            {
-                free(graph->nodes[j].name);
-            }
-            return NULL;
-        }
-        graph->nodes[i].flags = parser->rooms[i].flags;
-        if (parser->rooms[i].flags & ROOM_START)
-            graph->start_room_id = i;
-        else if (parser->rooms[i].flags & ROOM_END)
-            graph->end_room_id = i;
-        graph->nodes[i].bfs_marked = FALSE;
-        graph->nodes[i].enqueued = FALSE;
-        graph->nodes[i].enqueued_backward = FALSE;
-        graph->nodes[i].head = NULL;
+        if (graph->edge_dest[e] == dest)
+            return e;
     }
-    return graph;
+    return graph->edge_count;
+}
+
+// les liens et la table de hachage ne servent plus une fois le CSR
+// construit : on les rend avant d'allouer l'espace de travail du bfs
+static void release_parser_tables(lem_in_parser_t *parser)
+{
+    free(parser->links);
+    parser->links = NULL;
+    parser->link_capacity = 0;
+    free(parser->hash_table);
+    parser->hash_table = NULL;
+    parser->hash_size = 0;
 }
 
-// creer le graph donc allouer la memoire pour le graph et les noeuds
-t_graph *create_graph(const lem_in_parser_t *parser)
+// creer le graph : les noeuds remplis par le parser sont repris tels quels,
+// leurs noms restent dans le buffer d'entree
+t_graph *create_graph(lem_in_parser_t *parser, t_stats *stats)
 {
     t_graph *graph;
     size_t size = parser->room_count;
@@ -66,45 +94,51 @@ t_graph *create_graph(const lem_in_parser_t *parser)
     if (size == 0 || (graph = (t_graph*)malloc(sizeof(t_graph))) == NULL)
         return NULL;
 
+    arena_init(&graph->arena);
+    graph->stats = stats;
+    graph->budget = NULL;
+    graph->input = parser->input_buffer;
+    graph->nodes = parser->nodes;
+    parser->nodes = NULL;
+    parser->room_capacity = 0;
     graph->ants = parser->ant_count;
     graph->size = size;
     graph->paths_count = 0;
+    graph->lines_bound = 0;
     graph->old_output_lines = 0;
-    graph->start_room_id = INVALID_ROOM_ID;
-    graph->end_room_id = INVALID_ROOM_ID;
-    if ((graph->nodes = (t_node*)malloc(size * sizeof(t_node))) == NULL)
-    {
-        free(graph);
-        return NULL;
-    }
-    if (!(graph = graph_initializer(parser, graph)))
-    {
-        free(graph->nodes);
-        free(graph);
-        return NULL;
-    }
+    graph->start_room_id = parser->start_room_id;
+    graph->end_room_id = parser->end_room_id;
+    graph->edge_offset = NULL;
+    graph->edge_dest = NULL;
+    graph->edge_twin = NULL;
+    graph->edge_capacity = NULL;
+    graph->edge_count = 0;
+    graph->room_used = NULL;
+    ft_bzero(&graph->corridors, sizeof(graph->corridors));
     return graph;
 }
 
 // fonction main pour creer le graph
-t_graph *graph_builder(const lem_in_parser_t *parser)
+t_graph *graph_builder(lem_in_parser_t *parser, t_stats *stats)
 {
     t_graph *graph;
 
-    if ((graph = create_graph(parser)) == NULL)
+    if ((graph = create_graph(parser, stats)) == NULL)
         return NULL;
-    for (size_t i = 0; i < parser->link_count; i++)
+    if (build_edges(graph, parser) == FAILURE)
     {
-        if (create_edge(graph, parser->links[i].from, parser->links[i].to) == FAILURE)
-        {
-            free_graph(graph);
-            return NULL;
-        }
+        free_graph(graph);
+        return NULL;
     }
-    if (graph->start_room_id == INVALID_ROOM_ID || graph->end_room_id == INVALID_ROOM_ID || graph->start_room_id == graph->end_room_id)
+    release_parser_tables(parser);
+    if (graph->start_room_id == INVALID_ROOM_ID || graph->end_room_id == INVALID_ROOM_ID
+        || graph->start_room_id == graph->end_room_id
+        || prune_dead_ends(graph) == FAILURE || find_corridors(graph) == FAILURE
+        || bfs_workspace_init(graph) == FAILURE
+        || !(graph->room_used = arena_calloc(&graph->arena, graph->size, 1)))
     {
         free_graph(graph);
         return NULL;
     }
     return graph;
-}
\ No newline at end of file
+}
@@ -0,0 +1,174 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                         REDUCTION DU GRAPHE
+ *
+ * Une salle de degre <= 1 (hors start et end) ne peut etre sur aucun
+ * chemin, et la retirer peut en rendre une autre de degre 1 : on les
+ * retire de proche en proche, puis on compacte le CSR pour que les
+ * recherches ne parcourent plus que le coeur du graphe. Les salles gardent
+ * leur id, leur nom et leurs flags ; les salles retirees n'ont plus aucun
+ * passage, rien n'est donc a traduire a l'affichage.
+ *
+ * Reste ensuite les couloirs : des suites de salles de degre 2 entre deux
+ * autres salles. Un chemin qui entre dans un couloir le traverse en
+ * entier, le graphe divise en fait donc un seul arc (split_finder.c) et
+ * on garde ici la liste de ses salles pour les remettre dans les chemins.
+ *=========================================================================== */
+
+#define DEAD UINT32_MAX
+
+static inline int8_t is_endpoint(const t_graph *graph, size_t room)
+{
+    return room == graph->start_room_id || room == graph->end_room_id;
+}
+
+// degree[v] vaut DEAD pour les salles retirees
+static size_t mark_dead_ends(t_graph *graph, uint32_t *degree, uint32_t *queue)
+{
+    size_t front = 0, rear = 0;
+    uint32_t node, next;
+
+    for (size_t v = 0; v < graph->size; v++)
+    {
+        degree[v] = graph->edge_offset[v + 1] - graph->edge_offset[v];
+        if (degree[v] <= 1 && is_endpoint(graph, v) == FALSE)
+        {
+            degree[v] = DEAD;
+            queue[rear++] = (uint32_t)v;
+        }
+    }
+    while (front < rear)
+    {
+        node = queue[front++];
+        for (size_t e = graph->edge_offset[node]; e < graph->edge_offset[node + 1]; e++)
+        {
+            next = graph->edge_dest[e];
+            if (degree[next] == DEAD || --degree[next] > 1 || is_endpoint(graph, next))
+                continue;
+            degree[next] = DEAD;
+            queue[rear++] = next;
+        }
+    }
+    return rear;
+}
+
+// garder les passages entre salles vivantes, dans le meme ordre pour que
+// le bfs visite le coeur comme avant ; remap donne le nouvel index de
+// chaque passage garde, pour corriger edge_twin ensuite
+static void compact_edges(t_graph *graph, const uint32_t *degree, uint32_t *remap)
+{
+    uint32_t begin = 0, end, kept = 0;
+
+    for (size_t u = 0; u < graph->size; u++)
+    {
+        end = graph->edge_offset[u + 1];
+        for (uint32_t e = begin; e < end && degree[u] != DEAD; e++)
+        {
+            if (degree[graph->edge_dest[e]] == DEAD)
+                continue;
+            remap[e] = kept;
+            graph->edge_dest[kept] = graph->edge_dest[e];
+            graph->edge_twin[kept] = graph->edge_twin[e];
+            graph->edge_capacity[kept] = graph->edge_capacity[e];
+            kept++;
+        }
+        graph->edge_offset[u + 1] = kept;
+        begin = end;
+    }
+    for (uint32_t e = 0; e < kept; e++)
+        graph->edge_twin[e] = remap[graph->edge_twin[e]];
+    graph->edge_count = kept;
+}
+
+// a appeler une fois le CSR construit, avant toute recherche
+int8_t prune_dead_ends(t_graph *graph)
+{
+    t_arena_mark mark = arena_mark(&graph->arena);
+    uint32_t *degree = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t));
+    uint32_t *queue = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t));
+    uint32_t *remap = arena_alloc(&graph->arena, graph->edge_count * sizeof(uint32_t));
+    size_t dead;
+
+    if (!degree || !queue || !remap)
+        return FAILURE;
+    dead = mark_dead_ends(graph, degree, queue);
+    if (dead > 0)
+        compact_edges(graph, degree, remap);
+    graph->stats->rooms_pruned = dead;
+    arena_rewind(&graph->arena, mark);
+    return SUCCESS;
+}
+
+static inline int8_t in_corridor(const t_graph *graph, size_t room)
+{
+    return is_endpoint(graph, room) == FALSE
+        && graph->edge_offset[room + 1] - graph->edge_offset[room] == 2;
+}
+
+// suivre le couloir ou entre le passage e de la salle from, jusqu'a la
+// premiere salle qui n'est pas de degre 2 ; owner note le couloir de
+// chaque salle pour que l'autre bout le retrouve sans le reparcourir
+static void walk_corridor(t_graph *graph, uint32_t *owner, size_t from, size_t e)
+{
+    t_corridors *cor = &graph->corridors;
+    uint32_t c = (uint32_t)cor->count++;
+    uint32_t room = graph->edge_dest[e];
+    uint32_t back, filled = cor->first[c];
+
+    while (in_corridor(graph, room))
+    {
+        cor->rooms[filled++] = room;
+        owner[room] = c;
+        back = graph->edge_twin[e];
+        e = graph->edge_offset[room];
+        if (e == back)
+            e++;
+        room = graph->edge_dest[e];
+    }
+    cor->first[c + 1] = filled;
+    cor->end_a[c] = (uint32_t)from;
+    cor->end_b[c] = room;
+}
+
+// a appeler apres prune_dead_ends. Un passage porte le couloir ou il entre
+// ou celui de sa salle ; un couloir dont les deux bouts sont la meme salle
+// ne sert a aucun chemin, split_build l'ignore simplement
+int8_t find_corridors(t_graph *graph)
+{
+    t_corridors *cor = &graph->corridors;
+    size_t rooms = 0;
+    uint32_t *owner;
+    t_arena_mark mark;
+
+    for (size_t v = 0; v < graph->size; v++)
+        rooms += in_corridor(graph, v);
+    cor->count = 0;
+    cor->edge_corridor = arena_alloc(&graph->arena, (graph->edge_count + 1) * sizeof(uint32_t));
+    cor->first = arena_calloc(&graph->arena, rooms + 1, sizeof(uint32_t));
+    cor->rooms = arena_alloc(&graph->arena, (rooms + 1) * sizeof(uint32_t));
+    cor->end_a = arena_alloc(&graph->arena, (rooms + 1) * sizeof(uint32_t));
+    cor->end_b = arena_alloc(&graph->arena, (rooms + 1) * sizeof(uint32_t));
+    mark = arena_mark(&graph->arena);
+    owner = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t));
+    if (!cor->edge_corridor || !cor->first || !cor->rooms || !cor->end_a || !cor->end_b || !owner)
+        return FAILURE;
+    ft_memset(owner, 0xff, graph->size * sizeof(uint32_t));
+    for (size_t v = 0; v < graph->size; v++)
+    {
+        for (size_t e = graph->edge_offset[v]; e < graph->edge_offset[v + 1]; e++)
+        {
+            if (in_corridor(graph, v) == FALSE && in_corridor(graph, graph->edge_dest[e])
+                && owner[graph->edge_dest[e]] == NO_CORRIDOR)
+                walk_corridor(graph, owner, v, e);
+        }
+    }
+    for (size_t v = 0; v < graph->size; v++)
+    {
+        for (size_t e = graph->edge_offset[v]; e < graph->edge_offset[v + 1]; e++)
+            cor->edge_corridor[e] = in_corridor(graph, v) ? owner[v] : owner[graph->edge_dest[e]];
+    }
+    graph->stats->rooms_contracted = cor->first[cor->count];
+    arena_rewind(&graph->arena, mark);
+    return SUCCESS;
+}
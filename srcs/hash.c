@@ -1,69 +1,162 @@
 #include "lem_in.h"
 
-// djb2 hash algorithm - industry standard
-uint32_t hash_string(const char *str)
-{
-	if (!str)
-		return 0;
+// ============================================================================
+// HASH FUNCTION - wyhash-style: 64-bit words folded with a 64x64->128 multiply
+// ============================================================================
 
-	uint32_t hash = 5381;
-	int c;
+#define WY_P0 0xa0761d6478bd642full
+#define WY_P1 0xe7037ed1a0b428dbull
+#define WY_SEED 0x8ebc6af09c88c6e3ull
 
-	while ((c = *str++))
-		hash = ((hash << 5) + hash) + c; // hash * 33 + c
+static inline uint64_t wy_mix(uint64_t a, uint64_t b)
+{
+	__uint128_t r = (__uint128_t)a * b;
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
 
-	return hash;
+// Unaligned loads; memcpy compiles to a single mov
+static inline uint64_t wy_read8(const uint8_t *p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
 }
 
-bool hash_add_room(lem_in_parser_t *parser, const char *name, uint16_t room_id)
+static inline uint64_t wy_read4(const uint8_t *p)
 {
-	if (!parser || !name || !parser->hash_table)
-		return false;
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
 
-	uint32_t hash = hash_string(name);
-	uint32_t index = hash & (HASH_SIZE - 1);
-	uint32_t original_index = index;
+// Names are at most 255 bytes, so the 16-byte loop is all we need. Every
+// read stays inside [str, str + len): names are spans of the input buffer.
+uint32_t hash_string(const char *str, size_t len)
+{
+	const uint8_t *p = (const uint8_t *)str;
+	uint64_t seed = WY_SEED;
+	uint64_t a, b;
 
-	// Linear probing with wraparound
-	while (parser->hash_table[index].name != NULL)
+	if (len <= 16)
 	{
-		// Check for duplicate
-		if (ft_strncmp(parser->hash_table[index].name, name, ft_strlen(name)) == 0)
-			return false; // Duplicate found
+		if (len >= 4)
+		{
+			size_t half = (len >> 3) << 2;
+			a = (wy_read4(p) << 32) | wy_read4(p + half);
+			b = (wy_read4(p + len - 4) << 32) | wy_read4(p + len - 4 - half);
+		}
+		else if (len > 0)
+		{
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else
+	{
+		size_t i = len;
+		while (i > 16)
+		{
+			seed = wy_mix(wy_read8(p) ^ WY_P1, wy_read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = wy_read8(p + i - 16);
+		b = wy_read8(p + i - 8);
+	}
+	return (uint32_t)wy_mix(wy_mix(a ^ WY_P1, b ^ seed) ^ WY_P0 ^ len, seed ^ WY_P1);
+}
 
-		index = (index + 1) & (HASH_SIZE - 1);
+// ============================================================================
+// ROOM INDEX - open addressing, linear probing. Each slot caches the hash
+// and the name length so that probes over other names are rejected
+// without touching their bytes.
+// ============================================================================
 
-		// Table full check (should never happen with our size limits)
-		if (index == original_index)
-			return false;
-	}
+static inline bool slot_matches(const lem_in_parser_t *parser, const hash_entry_t *entry,
+	uint32_t hash, const char *name, size_t len)
+{
+	return entry->hash == hash && entry->name_len == len
+		&& memcmp(parser->input_buffer + entry->name_offset, name, len) == 0;
+}
 
-	// Add the entry
-	parser->hash_table[index].name = name;
-	parser->hash_table[index].room_id = room_id;
+// Insert without duplicate check, used when rehashing into a fresh table
+static void hash_insert(hash_entry_t *table, size_t size, const hash_entry_t *entry)
+{
+	uint32_t index = entry->hash & (size - 1);
 
-	return true;
+	while (table[index].name_len != 0)
+		index = (index + 1) & (size - 1);
+	table[index] = *entry;
 }
 
-int16_t hash_get_room_id(const lem_in_parser_t *parser, const char *name)
+// Make room for `count` entries while keeping the table at most half full.
+// The table doubles and every entry moves to its new slot using its cached
+// hash, without rehashing the name.
+bool hash_reserve(lem_in_parser_t *parser, size_t count)
 {
-	if (!parser || !name || !parser->hash_table)
-		return -1;
+	if (!parser)
+		return false;
+	if (count * 2 <= parser->hash_size)
+		return true;
 
-	uint32_t hash = hash_string(name);
-	uint32_t index = hash & (HASH_SIZE - 1);
-	uint32_t original_index = index;
+	size_t size = parser->hash_size ? parser->hash_size : HASH_INITIAL_SIZE;
+	while (count * 2 > size)
+		size *= 2;
 
-	while (parser->hash_table[index].name != NULL)
+	// calloc rather than ft_calloc: fresh pages from the system are
+	// already zero, the byte loop of ft_bzero showed up in profiles
+	hash_entry_t *table = calloc(size, sizeof(hash_entry_t));
+	if (!table)
+		return print_error(ERR_MEMORY, "hash table");
+
+	for (size_t i = 0; i < parser->hash_size; i++)
 	{
-		if (ft_strncmp(parser->hash_table[index].name, name, ft_strlen(name)) == 0)
-			return parser->hash_table[index].room_id;
+		if (parser->hash_table[i].name_len != 0)
+			hash_insert(table, size, &parser->hash_table[i]);
+	}
+	free(parser->hash_table);
+	parser->hash_table = table;
+	parser->hash_size = size;
+	return true;
+}
 
-		index = (index + 1) & (HASH_SIZE - 1);
+// Probe for a name: its slot when it is already there, otherwise the empty
+// slot that ends the probe, where it goes. hash is hash_string(name, len).
+// The table is never full, so the probe always ends.
+hash_entry_t *hash_find_slot(const lem_in_parser_t *parser, const char *name, size_t len, uint32_t hash)
+{
+	uint32_t mask = parser->hash_size - 1;
+	uint32_t index = hash & mask;
 
-		if (index == original_index)
-			break; // Searched entire table
+	// Linear probing with wraparound
+	while (parser->hash_table[index].name_len != 0)
+	{
+		if (slot_matches(parser, &parser->hash_table[index], hash, name, len))
+			break;
+		index = (index + 1) & mask;
 	}
+	return &parser->hash_table[index];
+}
+
+// Fill the empty slot hash_find_slot returned. The caller reserves room
+// with hash_reserve before the probe, so the slot stays valid.
+void hash_add_room(lem_in_parser_t *parser, hash_entry_t *slot, const char *name, size_t len, uint32_t hash,
+	uint32_t room_id)
+{
+	slot->name_offset = (size_t)(name - parser->input_buffer);
+	slot->hash = hash;
+	slot->name_len = (uint16_t)len;
+	slot->room_id = room_id;
+}
+
+// Returns INVALID_ROOM_ID when the name is unknown
+uint32_t hash_get_room_id(const lem_in_parser_t *parser, const char *name, size_t len)
+{
+	if (!parser || !name || !parser->hash_table)
+		return INVALID_ROOM_ID;
 
-	return -1; // Not found
+	const hash_entry_t *slot = hash_find_slot(parser, name, len, hash_string(name, len));
+	return slot->name_len != 0 ? slot->room_id : INVALID_ROOM_ID;
 }
@@ -1,86 +1,39 @@
 #include "lem_in.h"
 
-t_paths	*init_paths(t_graph *graph, t_list *aug_paths)
+// les chemins restent dans l'ensemble de l'algorithme, t_paths ne fait
+// que le referencer. tout est pris dans l'arena et libere avec le graph
+t_paths	*init_paths(t_graph *graph, const t_path_set *set)
 {
-	t_list		*tmp;
-	size_t		i;
-	t_list		*curr;
 	t_paths		*paths;
 
-	if (!(paths = malloc(sizeof(t_paths))))
+	if (!(paths = arena_alloc(&graph->arena, sizeof(t_paths))))
 		return (NULL);
-	paths->array = NULL;
+	paths->set = set;
 	paths->n = NULL;
 	paths->len = NULL;
-	paths->available = NULL;
-	paths->ants_to_paths = NULL;
-	if (!(paths->array = malloc(graph->paths_count * sizeof(t_list*))))
-		return (free_paths(paths, graph));
-	i = 0;
-	while (i < graph->paths_count)
-		paths->array[i++] = NULL;
-	i = 0;
-	curr = aug_paths;
-	while (curr != NULL)
-	{
-        size_t *dup = malloc(sizeof(size_t));
-        if (!dup)
-            return (free_paths(paths, graph));
-        *dup = *(size_t *)curr->content;
-        if (!(tmp = ft_lstnew(dup)))
-        {
-            free(dup);
-            return (free_paths(paths, graph));
-        }
-		ft_lstappend(&paths->array[i], tmp);
-		curr = curr->next;
-		if (curr != NULL && *(size_t *)curr->content == graph->start_room_id)
-			i++;
-	}
 	return (paths);
 }
 
-t_paths	*init_output(t_graph *graph, t_list *aug_paths)
+t_paths	*init_output(t_graph *graph, const t_path_set *set)
 {
 	t_paths	*paths;
 	size_t	i;
 
-	if (!(paths = init_paths(graph, aug_paths)))
-		return (free_paths(paths, graph));
-	if (!(paths->ants_to_paths = malloc(graph->ants * sizeof(size_t))))
-		return (free_paths(paths, graph));
+	if (!(paths = init_paths(graph, set)))
+		return (NULL);
 	if (graph->paths_count)
 	{
-		if (!(paths->n = malloc(graph->paths_count * sizeof(size_t))))
-			return (free_paths(paths, graph));
-		if (!(paths->len = malloc(graph->paths_count * sizeof(size_t))))
-			return (free_paths(paths, graph));
+		if (!(paths->n = arena_alloc(&graph->arena, graph->paths_count * sizeof(size_t))))
+			return (NULL);
+		if (!(paths->len = arena_alloc(&graph->arena, graph->paths_count * sizeof(size_t))))
+			return (NULL);
 	}
 	i = 0;
 	while (i < graph->paths_count)
 	{
-		paths->len[i] = ft_lstsize(paths->array[i]) - 1;
+		paths->len[i] = path_len(set, i) - 1;
 		paths->n[i++] = 0;
 	}
-	i = 0;
-	while (i < graph->ants)
-		paths->ants_to_paths[i++] = 0;
 	paths->output_lines = 0;
 	return (paths);
 }
-
-
-//verifie le nombre de lignes de sortie grace a la longueur de la plus courte chaine
-void init_lines(t_paths *paths, t_graph *graph)
-{
-	size_t tmp = 0;
-
-	paths->output_lines = ft_lstsize(paths->array[0]) - 1;
-	for (size_t i = 0; i < graph->paths_count; i++)
-	{
-		tmp = ft_lstsize(paths->array[i]) - 1;
-		if (tmp < paths->output_lines)
-			paths->output_lines = tmp;
-	}
-}
-
@@ -1,11 +1,53 @@
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS, madvise
 #include "lem_in.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-bool read_input(lem_in_parser_t *parser)
+// Map a regular file straight into memory. The mapping is private so the
+// parser can still write its NUL terminators in place (copy-on-write), and
+// it is backed by one extra anonymous zero page so input_buffer[size] is
+// always a valid '\0', even when the file size is a multiple of the page size.
+static bool map_input(lem_in_parser_t *parser, size_t size)
 {
-	if (!parser)
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	size_t map_size = (size + 1 + page - 1) & ~(page - 1);
+
+	char *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+		return false;
+
+	if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, STDIN_FILENO, 0) == MAP_FAILED)
+	{
+		munmap(base, map_size);
 		return false;
+	}
+	madvise(base, map_size, MADV_SEQUENTIAL);
 
-	size_t capacity = 4096;
+	parser->input_buffer = base;
+	parser->input_size = size;
+	parser->input_map_size = map_size;
+	return true;
+}
+
+// Read and drop whatever the writer still sends once parsing has stopped,
+// so its writes succeed instead of failing with EPIPE/SIGPIPE, as they
+// did when the whole input was read before parsing.
+static void drain_input(void)
+{
+	char scratch[4096];
+
+	while (read(STDIN_FILENO, scratch, sizeof(scratch)) > 0)
+		;
+}
+
+// Fallback for pipes and ttys: read fixed-size chunks into a buffer that
+// grows geometrically. No zero-filling, and realloc may remap large blocks
+// instead of copying them. The lines of each chunk are parsed as soon as
+// it arrives, while the writer fills the pipe with the next one; once the
+// map ends on an empty line or an error, the rest of stdin is drained.
+static bool stream_input(lem_in_parser_t *parser)
+{
+	size_t capacity = INPUT_CHUNK_SIZE;
 	size_t size = 0;
 
 	parser->input_buffer = malloc(capacity);
@@ -13,24 +55,28 @@ bool read_input(lem_in_parser_t *parser)
 		return print_error(ERR_MEMORY, "input buffer");
 
 	ssize_t bytes_read;
-	while ((bytes_read = read(STDIN_FILENO, parser->input_buffer + size, capacity - size)) > 0)
+	while ((bytes_read = read(STDIN_FILENO, parser->input_buffer + size, capacity - size - 1)) > 0)
 	{
 		size += bytes_read;
-
-		if (size >= capacity - 1)
+		parser->input_size = size;
+		if (!parse_chunk(parser, false))
+		{
+			drain_input();
+			return false;
+		}
+		if (parser->parse_done)
 		{
-			if (capacity >= MAX_INPUT_SIZE)
-				return print_error(ERR_INPUT_READ, "input too large");
+			drain_input();
+			break;
+		}
 
-			capacity *= 2;
-			if (capacity > MAX_INPUT_SIZE)
-			{
-				capacity = MAX_INPUT_SIZE;
-			}
-			char *new_buffer = ft_realloc(parser->input_buffer, capacity / 2, capacity);
+		if (capacity - size - 1 < INPUT_CHUNK_SIZE / 2)
+		{
+			char *new_buffer = realloc(parser->input_buffer, capacity * 2);
 			if (!new_buffer)
 				return print_error(ERR_MEMORY, "input buffer resize");
 			parser->input_buffer = new_buffer;
+			capacity *= 2;
 		}
 	}
 
@@ -42,3 +88,16 @@ bool read_input(lem_in_parser_t *parser)
 
 	return size > 0;
 }
+
+bool read_input(lem_in_parser_t *parser)
+{
+	if (!parser)
+		return false;
+
+	struct stat st;
+	if (fstat(STDIN_FILENO, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+		&& lseek(STDIN_FILENO, 0, SEEK_CUR) == 0 && map_input(parser, (size_t)st.st_size))
+		return true;
+
+	return stream_input(parser);
+}
@@ -1,44 +1,80 @@
 #include "lem_in.h"
 
-int main(void)
+// the graph is gone after free_graph, so its arena counter is read first.
+// Portfolio workers have already added the blocks of their own arenas.
+static int report_and_free(t_stats *stats, const t_options *options, t_graph *graph, int status)
 {
+	stats->arena_blocks += graph->arena.allocations;
+	if (!stats_report(stats, options))
+		status = EXIT_FAILURE;
+	free_graph(graph);
+	return status;
+}
+
+int main(int argc, char **argv)
+{
+	t_options options;
+	t_stats stats;
+
+	if (!parse_options(argc, argv, &options))
+		return EXIT_FAILURE;
+	stats_start(&stats);
+
 	lem_in_parser_t *parser = parser_create();
 	t_graph *graph;
-	t_list *aug_paths;
+	t_path_set paths;
 	int status = EXIT_SUCCESS;
 
 	if (!parser)
 		return EXIT_FAILURE;
 
-	if (!read_input(parser) || !parse_input(parser) || (graph = graph_builder(parser)) == NULL)
+	if (!read_input(parser))
+	{
+		parser_destroy(parser);
+		return EXIT_FAILURE;
+	}
+	stats_lap(&stats, STAGE_READ_INPUT);
+	if (!parse_input(parser))
 	{
 		parser_destroy(parser);
 		return EXIT_FAILURE;
 	}
-	
+	stats_lap(&stats, STAGE_PARSE_INPUT);
+	if ((graph = graph_builder(parser, &stats)) == NULL)
+	{
+		parser_destroy(parser);
+		return EXIT_FAILURE;
+	}
+	stats_lap(&stats, STAGE_GRAPH_BUILDER);
+
 	if (is_valid_path(graph) == FALSE)
 	{
 		print_error(ERR_NO_PATH, NULL);
-		free_graph(graph);
+		report_and_free(&stats, &options, graph, EXIT_FAILURE);
 		parser_destroy(parser);
 		return EXIT_FAILURE;
 	}
-	
+	stats_lap(&stats, STAGE_CHECK_PATH);
+
 	if (!display_input(parser))
 		status = EXIT_FAILURE;
-	
-	if ((aug_paths = find_paths(graph)) == NULL)
+	stats_lap(&stats, STAGE_DISPLAY);
+
+	path_set_init(&paths);
+	if (search_paths(graph, &options, &paths) == FAILURE)
 	{
-		free_graph(graph);
+		path_set_free(&paths);
+		report_and_free(&stats, &options, graph, EXIT_FAILURE);
 		parser_destroy(parser);
 		return EXIT_FAILURE;
 	}
-	
-	if (solver(graph, aug_paths) == FAILURE)
-		return EXIT_FAILURE;
-	
-	ft_lstclear(&aug_paths, del_content);
-	free_graph(graph);
+	stats_lap(&stats, STAGE_FIND_PATHS);
+
+	if (solver(graph, &paths) == FAILURE)
+		status = EXIT_FAILURE;
+
+	path_set_free(&paths);
+	status = report_and_free(&stats, &options, graph, status);
 	parser_destroy(parser);
 	return (status);
 }
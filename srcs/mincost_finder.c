@@ -0,0 +1,197 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                         MIN-COST FLOW PATHS FINDER
+ *
+ * Plus courts chemins successifs sur le graphe divise : chaque lien coute
+ * 1 (un couloir autant que ses liens), l'arc interne d'une salle 0 et un
+ * arc residuel l'oppose de son jumeau. Avec k unites de flot, les k
+ * chemins ont donc la plus petite longueur totale possible C(k). Chaque
+ * flot est evalue comme par find_solution, avec count_output_lines sur
+ * les longueurs de ses chemins : un chemin trop long pour recevoir des
+ * fourmis ne compte pas.
+ *
+ * Le Dijkstra travaille sur les couts reduits c(u, v) + pi(u) - pi(v),
+ * positifs grace aux potentiels de Johnson ; il s'arrete des que le puits
+ * sort du tas.
+ *=========================================================================== */
+
+typedef struct s_mincost
+{
+    t_split_graph split;
+    int32_t *potential;
+    uint64_t *heap;   // (distance << 32) | noeud, tas binaire minimum
+    size_t heap_size;
+} t_mincost;
+
+// un arc coute les liens qu'il represente, l'arc interne d'une salle 0
+static inline int32_t arc_cost(const t_split_graph *split, uint32_t a)
+{
+    return split->forward[a] ? (int32_t)split->links[a] : -(int32_t)split->links[a];
+}
+
+static void heap_push(t_mincost *mc, uint64_t key)
+{
+    size_t i = mc->heap_size++;
+
+    while (i > 0 && mc->heap[(i - 1) / 2] > key)
+    {
+        mc->heap[i] = mc->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    mc->heap[i] = key;
+}
+
+static uint64_t heap_pop(t_mincost *mc)
+{
+    uint64_t top = mc->heap[0];
+    uint64_t last = mc->heap[--mc->heap_size];
+    size_t i = 0, child;
+
+    while ((child = 2 * i + 1) < mc->heap_size)
+    {
+        if (child + 1 < mc->heap_size && mc->heap[child + 1] < mc->heap[child])
+            child++;
+        if (mc->heap[child] >= last)
+            break;
+        mc->heap[i] = mc->heap[child];
+        i = child;
+    }
+    mc->heap[i] = last;
+    return top;
+}
+
+// chaque relachement pousse au plus une entree : arc_count + 1 suffit
+static int8_t mincost_build(t_mincost *mc, t_graph *graph)
+{
+    t_split_graph *split = &mc->split;
+
+    if (split_build(split, graph) == FAILURE)
+        return FAILURE;
+    mc->potential = arena_calloc(split->arena, split->node_count, sizeof(int32_t));
+    mc->heap = arena_alloc(split->arena, (split->arc_count + 1) * sizeof(uint64_t));
+    mc->heap_size = 0;
+    if (!mc->potential || !mc->heap)
+        return FAILURE;
+    return SUCCESS;
+}
+
+static inline void relax(t_mincost *mc, uint32_t node, uint32_t a, uint32_t dist)
+{
+    t_split_graph *split = &mc->split;
+    uint32_t next = split->dest[a];
+    uint32_t reduced = (uint32_t)(arc_cost(split, a)
+        + mc->potential[node] - mc->potential[next]);
+
+    if (split->visited[next] == split->epoch && split->dist[next] <= dist + reduced)
+        return;
+    split->visited[next] = split->epoch;
+    split->dist[next] = dist + reduced;
+    split->prev_arc[next] = a;
+    heap_push(mc, ((uint64_t)(dist + reduced) << 32) | next);
+}
+
+// Dijkstra de start_out a end_in sur les couts reduits
+static int8_t mincost_dijkstra(t_mincost *mc)
+{
+    t_split_graph *split = &mc->split;
+    uint64_t key;
+    uint32_t node, dist;
+
+    split->epoch++;
+    split->stats->bfs_calls++;
+    split->visited[split->source] = split->epoch;
+    split->dist[split->source] = 0;
+    mc->heap_size = 0;
+    heap_push(mc, split->source);
+    while (mc->heap_size > 0)
+    {
+        key = heap_pop(mc);
+        node = (uint32_t)key;
+        dist = (uint32_t)(key >> 32);
+        if (dist != split->dist[node])
+            continue;
+        if (node == split->sink)
+            return TRUE;
+        split->stats->edges_relaxed += split->offset[node + 1] - split->offset[node];
+        for (uint32_t a = split->offset[node]; a < split->offset[node + 1]; a++)
+        {
+            if (split->capacity[a] != 0)
+                relax(mc, node, a, dist);
+        }
+    }
+    return FALSE;
+}
+
+// pi += min(dist, dist(puits)) garde les couts reduits positifs meme si
+// le Dijkstra s'est arrete au puits ; pi(puits) devient alors la longueur
+// du chemin trouve, puisque pi(source) reste nul
+static void update_potentials(t_mincost *mc)
+{
+    t_split_graph *split = &mc->split;
+    uint32_t sink_dist = split->dist[split->sink];
+
+    for (size_t n = 0; n < split->node_count; n++)
+    {
+        if (split->visited[n] == split->epoch && split->dist[n] < sink_dist)
+            mc->potential[n] += (int32_t)split->dist[n];
+        else
+            mc->potential[n] += (int32_t)sink_dist;
+    }
+}
+
+// j chemins de longueur totale S demandent au moins (ants + S + j - 1) / j - 1
+// tours, et S >= C(j) : tout flot a m unites, evalue sur ses j chemins
+// utilises, fait donc au moins aussi mal que C(j). Pour j <= k ce minorant
+// vaut deja best_lines ou plus ; les increments de C ne font que croitre,
+// donc des que le prochain atteint best_lines aucun j plus grand n'y arrive
+static int8_t stop_before(t_mincost *mc, t_graph *graph, size_t best_lines)
+{
+    if (best_lines == SIZE_MAX || (size_t)mc->potential[mc->split.sink] < best_lines)
+        return FALSE;
+    graph->stats->early_stop = 1;
+    return TRUE;
+}
+
+// a chaque augmentation le flot a k unites et une longueur totale minimale,
+// on garde l'ensemble du meilleur k
+int8_t find_paths_mincost(t_graph *graph, t_path_set *paths)
+{
+    t_mincost mc;
+    size_t best_lines = SIZE_MAX, best_count = 0;
+    size_t *len, count, lines;
+
+    if (mincost_build(&mc, graph) == FAILURE
+        || !(len = arena_alloc(&graph->arena, (graph->edge_offset[graph->start_room_id + 1]
+            - graph->edge_offset[graph->start_room_id] + 1) * sizeof(size_t))))
+    {
+        split_destroy(&mc.split);
+        return FAILURE;
+    }
+    while (keep_searching(graph, best_lines) == TRUE && mincost_dijkstra(&mc) == TRUE)
+    {
+        update_potentials(&mc);
+        if (stop_before(&mc, graph, best_lines) == TRUE)
+            break;
+        split_augment(&mc.split);
+        count = split_flow_lengths(&mc.split, graph, len);
+        lines = count_output_lines(len, count, graph->ants);
+        if (lines < best_lines)
+        {
+            if (split_flow_to_paths(&mc.split, graph, paths) == FAILURE)
+            {
+                best_count = 0;
+                break;
+            }
+            best_lines = lines;
+            best_count = count;
+            graph->stats->augment_accepted++;
+        }
+        else
+            graph->stats->augment_rejected++;
+    }
+    split_destroy(&mc.split);
+    graph->paths_count = best_count;
+    graph->old_output_lines = best_lines;
+    return best_count ? SUCCESS : FAILURE;
+}
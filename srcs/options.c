@@ -0,0 +1,75 @@
+#include "lem_in.h"
+
+static bool parse_engine(const char *name, t_options *options)
+{
+	if (ft_strncmp(name, "heuristic", 10) == 0)
+		options->engine = ENGINE_HEURISTIC;
+	else if (ft_strncmp(name, "split", 6) == 0)
+		options->engine = ENGINE_SPLIT;
+	else if (ft_strncmp(name, "mincost", 8) == 0)
+		options->engine = ENGINE_MINCOST;
+	else if (ft_strncmp(name, "portfolio", 10) == 0)
+		options->engine = ENGINE_PORTFOLIO;
+	else
+		return print_error(ERR_INVALID_OPTION, name);
+	return true;
+}
+
+// Positive decimal number, no sign, no overflow
+static bool parse_limit(const char *arg, const char *str, size_t *value)
+{
+	size_t result = 0;
+
+	if (!*str)
+		return print_error(ERR_INVALID_OPTION, arg);
+	for (; *str; str++)
+	{
+		if (*str < '0' || *str > '9' || result > (SIZE_MAX - 9) / 10)
+			return print_error(ERR_INVALID_OPTION, arg);
+		result = result * 10 + (size_t)(*str - '0');
+	}
+	if (result == 0)
+		return print_error(ERR_INVALID_OPTION, arg);
+	*value = result;
+	return true;
+}
+
+// Command line: lem-in [--engine=split|heuristic|mincost|portfolio] [--stats[=FILE]]
+//                      [--budget=MS] [--budget-bfs=N] < map
+bool parse_options(int argc, char **argv, t_options *options)
+{
+	options->engine = ENGINE_SPLIT;
+	options->stats = false;
+	options->stats_path = NULL;
+	options->budget_ms = 0;
+	options->budget_bfs = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (ft_strncmp(argv[i], "--engine=", 9) == 0)
+		{
+			if (!parse_engine(argv[i] + 9, options))
+				return false;
+		}
+		else if (ft_strncmp(argv[i], "--stats", 8) == 0)
+			options->stats = true;
+		else if (ft_strncmp(argv[i], "--stats=", 8) == 0 && argv[i][8])
+		{
+			options->stats = true;
+			options->stats_path = argv[i] + 8;
+		}
+		else if (ft_strncmp(argv[i], "--budget=", 9) == 0)
+		{
+			if (!parse_limit(argv[i], argv[i] + 9, &options->budget_ms))
+				return false;
+		}
+		else if (ft_strncmp(argv[i], "--budget-bfs=", 13) == 0)
+		{
+			if (!parse_limit(argv[i], argv[i] + 13, &options->budget_bfs))
+				return false;
+		}
+		else
+			return print_error(ERR_INVALID_OPTION, argv[i]);
+	}
+	return true;
+}
@@ -1,16 +1,67 @@
 #include "lem_in.h"
+#include <sys/uio.h>
 
+#define ECHO_IOV_BATCH 512
+
+// writev until every byte of the batch is out, resuming after short writes
+static bool writev_all(int fd, struct iovec *iov, int count)
+{
+	while (count > 0)
+	{
+		ssize_t written = writev(fd, iov, count);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		while (count > 0 && (size_t)written >= iov->iov_len)
+		{
+			written -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = (char *)iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+	return true;
+}
+
+// Echo the accepted map straight from the input buffer. Each span is
+// followed by a newline: the original '\n' when there is one right after
+// it, so a well-formed map goes out as a single iovec.
 bool display_input(const lem_in_parser_t *parser)
 {
 	if (!parser)
 		return false;
 
-	t_list *current = parser->file_content;
-	while (current)
+	static char newline[] = "\n";
+	struct iovec iov[ECHO_IOV_BATCH * 2];
+	int count = 0;
+
+	for (size_t i = 0; i < parser->echo_count; i++)
 	{
-		ft_putendl_fd((char *)current->content, 1);
-		current = current->next;
+		const span_t *span = &parser->echo_spans[i];
+		char *start = parser->input_buffer + span->offset;
+		size_t end = span->offset + span->len;
+
+		if (end < parser->input_size && parser->input_buffer[end] == '\n')
+			iov[count++] = (struct iovec){start, span->len + 1};
+		else
+		{
+			iov[count++] = (struct iovec){start, span->len};
+			iov[count++] = (struct iovec){newline, 1};
+		}
+		if (count >= ECHO_IOV_BATCH * 2 - 1)
+		{
+			if (!writev_all(STDOUT_FILENO, iov, count))
+				return false;
+			count = 0;
+		}
 	}
 
-	return true;
+	return writev_all(STDOUT_FILENO, iov, count);
 }
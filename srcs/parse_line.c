@@ -1,8 +1,9 @@
 #include "lem_in.h"
 
-static char *extract_room_name(char *line, char **name_out)
+// Locate the room name at the start of the line without modifying it
+static char *extract_room_name(char *line, char **name_out, size_t *len_out)
 {
-	if (!line || !name_out)
+	if (!line || !name_out || !len_out)
 		return NULL;
 
 	char *p = line;
@@ -22,14 +23,15 @@ static char *extract_room_name(char *line, char **name_out)
 	if (!*p)
 		return NULL; // No space after name
 
-	*p = '\0';	  // Null terminate name
+	*len_out = (size_t)(p - line);
 	return p + 1; // Return pointer after name
 }
 
-// Extract coordinates from line, returns true on success
-static bool extract_coordinates(char *p, char **x_out, char **y_out)
+// Locate both coordinates, returns true on success. Each token is
+// reported as a [start, end) range; the line itself is left untouched.
+static bool extract_coordinates(char *p, char **x_out, char **x_end, char **y_out, char **y_end)
 {
-	if (!p || !x_out || !y_out)
+	if (!p || !x_out || !x_end || !y_out || !y_end)
 		return false;
 
 	// Skip whitespace before X
@@ -42,7 +44,7 @@ static bool extract_coordinates(char *p, char **x_out, char **y_out)
 		p++;
 	if (!*p)
 		return false; // No space after X
-	*p = '\0';
+	*x_end = p;
 	p++;
 
 	// Skip whitespace before Y
@@ -53,32 +55,32 @@ static bool extract_coordinates(char *p, char **x_out, char **y_out)
 	*y_out = p;
 	while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
 		p++;
+	*y_end = p;
 
-	// Null-terminate Y coordinate
-	if (*p)
-	{
-		*p = '\0';
+	// Check for trailing characters
+	while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
 		p++;
 
-		// Check for trailing characters
-		while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
-			p++;
-
-		return *p == '\0'; // Should be end of line
-	}
+	return *p == '\0'; // Should be end of line
+}
 
-	return true; // End of string, that's fine
+// Report an error whose context is the room name. The line is being
+// rejected, so it is fine to terminate the name in place for printing.
+static bool room_error(error_code_t code, char *name, size_t len)
+{
+	name[len] = '\0';
+	return print_error(code, name);
 }
 
 // Apply start/end flags to room
-static bool apply_room_flags(lem_in_parser_t *parser, room_t *room, int next_flag)
+static bool apply_room_flags(lem_in_parser_t *parser, t_node *room, uint32_t room_id, int next_flag)
 {
 	if (next_flag == 1) // ##start
 	{
 		if (parser->has_start)
 			return print_error(ERR_MULTIPLE_START, NULL);
 		room->flags = ROOM_START;
-		parser->start_room_id = room->id;
+		parser->start_room_id = room_id;
 		parser->has_start = true;
 	}
 	else if (next_flag == 2) // ##end
@@ -86,19 +88,52 @@ static bool apply_room_flags(lem_in_parser_t *parser, room_t *room, int next_fla
 		if (parser->has_end)
 			return print_error(ERR_MULTIPLE_END, NULL);
 		room->flags = ROOM_END;
-		parser->end_room_id = room->id;
+		parser->end_room_id = room_id;
 		parser->has_end = true;
 	}
 	return true;
 }
 
+// Make room for one more room in the nodes array and the hash table
+static bool reserve_room(lem_in_parser_t *parser)
+{
+	if (parser->room_count == parser->room_capacity)
+	{
+		size_t capacity = parser->room_capacity ? parser->room_capacity * 2 : ROOMS_INITIAL_CAPACITY;
+		t_node *nodes = realloc(parser->nodes, capacity * sizeof(t_node));
+		if (!nodes)
+			return print_error(ERR_MEMORY, "rooms array");
+		parser->nodes = nodes;
+		parser->room_capacity = capacity;
+	}
+	return hash_reserve(parser, parser->room_count + 1);
+}
+
+// Make room for one more link
+static bool reserve_link(lem_in_parser_t *parser)
+{
+	if (parser->link_count == parser->link_capacity)
+	{
+		size_t capacity = parser->link_capacity ? parser->link_capacity * 2 : LINKS_INITIAL_CAPACITY;
+		link_t *links = realloc(parser->links, capacity * sizeof(link_t));
+		if (!links)
+			return print_error(ERR_MEMORY, "links array");
+		parser->links = links;
+		parser->link_capacity = capacity;
+	}
+	return true;
+}
+
 // ============================================================================
 // MAIN PARSING LOGIC - Specialized room and link parsing
 // ============================================================================
 
-bool parse_room_line(lem_in_parser_t *parser, char *line, int next_flag)
+// Room lines in the "name x y" shape take their tokens from the scan, any
+// other spacing goes through extract_room_name and extract_coordinates.
+// Errors come in the same order either way.
+bool parse_room_line(lem_in_parser_t *parser, char *line, const line_scan_t *scan, int next_flag)
 {
-	if (!parser || !line)
+	if (!parser || !line || !scan)
 		return false;
 
 	// Check room limit
@@ -106,93 +141,105 @@ bool parse_room_line(lem_in_parser_t *parser, char *line, int next_flag)
 		return print_error(ERR_TOO_MANY_ROOMS, NULL);
 
 	// Extract room name
-	char *name;
-	char *rest = extract_room_name(line, &name);
-	if (!rest)
-		return print_error(!name ? ERR_ROOM_NAME_INVALID : ERR_INVALID_LINE, !name ? line : line);
+	bool simple = scan_is_room_shape(line, scan);
+	char *name = line;
+	size_t name_len = 0;
+	char *rest = NULL;
+	if (simple)
+		name_len = (size_t)(scan->blank[0] - line);
+	else if (!(rest = extract_room_name(line, &name, &name_len)))
+		return print_error(!name ? ERR_ROOM_NAME_INVALID : ERR_INVALID_LINE, line);
 
 	// Validate room name
 	error_code_t error = ERR_NONE;
-	if (!validate_room_name(name, &error))
-		return print_error(error, name);
+	if (!validate_room_name(name, name_len, &error))
+		return room_error(error, name, name_len);
 
-	// Check for duplicates
-	if (hash_get_room_id(parser, name) >= 0)
-		return print_error(ERR_ROOM_DUPLICATE, name);
+	// Check for duplicates. The probe stops on the slot the room will
+	// take, so the table is grown first to keep that slot valid.
+	if (!reserve_room(parser))
+		return false;
+	uint32_t hash = hash_string(name, name_len);
+	hash_entry_t *slot = hash_find_slot(parser, name, name_len, hash);
+	if (slot->name_len != 0)
+		return room_error(ERR_ROOM_DUPLICATE, name, name_len);
 
 	// Extract coordinates
-	char *x_str, *y_str;
-	if (!extract_coordinates(rest, &x_str, &y_str))
-		return print_error(ERR_INVALID_LINE, line);
+	char *x_str, *x_end, *y_str, *y_end;
+	if (simple)
+	{
+		x_str = scan->blank[0] + 1;
+		x_end = scan->blank[1];
+		y_str = scan->blank[1] + 1;
+		y_end = scan->end;
+	}
+	else if (!extract_coordinates(rest, &x_str, &x_end, &y_str, &y_end))
+		return room_error(ERR_INVALID_LINE, name, name_len);
 
-	// Validate coordinates
-	if (!validate_coordinates(x_str, y_str, &error))
-		return print_error(error, line);
+	if (!validate_coordinates(x_str, x_end, y_str, y_end, &error))
+		return room_error(error, name, name_len);
 
-	// Create room
-	uint16_t room_id = (uint16_t)parser->room_count;
-	room_t *room = &parser->rooms[parser->room_count];
+	// Create the node the graph will use, coordinates are only validated
+	uint32_t room_id = (uint32_t)parser->room_count;
+	t_node *room = &parser->nodes[parser->room_count];
 
-	room->name = name;
-	room->x = (int32_t)ft_atoi(x_str);
-	room->y = (int32_t)ft_atoi(y_str);
+	room->name_offset = (size_t)(name - parser->input_buffer);
+	room->name_len = (uint16_t)name_len;
 	room->flags = ROOM_NORMAL;
-	room->id = room_id;
 
 	// Apply start/end flags
-	if (!apply_room_flags(parser, room, next_flag))
+	if (!apply_room_flags(parser, room, room_id, next_flag))
 		return false;
 
-	// Add to hash table
-	if (!hash_add_room(parser, room->name, room_id))
-		return print_error(ERR_ROOM_DUPLICATE, name);
-
+	hash_add_room(parser, slot, name, name_len, hash, room_id);
 	parser->room_count++;
 	return true;
 }
 
-bool parse_link_line(lem_in_parser_t *parser, char *line)
+// The scan gives the first dash and the end of the line, no rescans
+bool parse_link_line(lem_in_parser_t *parser, char *line, const line_scan_t *scan)
 {
-	if (!parser || !line)
+	if (!parser || !line || !scan)
 		return false;
 
-	char *dash = ft_strchr(line, '-');
-	if (!dash || dash == line || !dash[1])
+	char *dash = scan->dash;
+	if (!dash || dash == line || dash + 1 == scan->end)
 		return print_error(ERR_LINK_INVALID, line);
 
 	if (parser->link_count >= MAX_LINKS)
 		return print_error(ERR_TOO_MANY_LINKS, NULL);
+	if (!reserve_link(parser))
+		return false;
 
-	// Split the line at the dash
-	*dash = '\0';
+	// Split the line at the dash, trimming whitespace around both names
 	char *room1_name = line;
-	char *room2_name = dash + 1;
-
-	// Trim whitespace
-	char *p = room1_name + ft_strlen(room1_name) - 1;
-	while (p >= room1_name && (*p == ' ' || *p == '\t'))
-		*p-- = '\0';
+	char *room1_end = dash;
+	while (room1_end > room1_name && (room1_end[-1] == ' ' || room1_end[-1] == '\t'))
+		room1_end--;
 
+	char *room2_name = dash + 1;
 	while (*room2_name == ' ' || *room2_name == '\t')
 		room2_name++;
-	p = room2_name + ft_strlen(room2_name) - 1;
-	while (p >= room2_name && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
-		*p-- = '\0';
+	char *room2_end = scan->end;
+	while (room2_end > room2_name && (room2_end[-1] == ' ' || room2_end[-1] == '\t'))
+		room2_end--;
+
+	size_t room1_len = (size_t)(room1_end - room1_name);
 
 	// Get room IDs
-	int16_t room1_id = hash_get_room_id(parser, room1_name);
-	int16_t room2_id = hash_get_room_id(parser, room2_name);
+	uint32_t room1_id = hash_get_room_id(parser, room1_name, room1_len);
+	uint32_t room2_id = hash_get_room_id(parser, room2_name, (size_t)(room2_end - room2_name));
 
-	if (room1_id < 0 || room2_id < 0)
-		return print_error(ERR_LINK_ROOM_NOT_FOUND, line);
+	if (room1_id == INVALID_ROOM_ID || room2_id == INVALID_ROOM_ID)
+		return room_error(ERR_LINK_ROOM_NOT_FOUND, room1_name, room1_len);
 
 	if (room1_id == room2_id)
-		return print_error(ERR_LINK_SELF, line);
+		return room_error(ERR_LINK_SELF, room1_name, room1_len);
 
 	// Add the link
 	link_t *link = &parser->links[parser->link_count];
-	link->from = (uint16_t)room1_id;
-	link->to = (uint16_t)room2_id;
+	link->from = room1_id;
+	link->to = room2_id;
 
 	parser->link_count++;
 	return true;
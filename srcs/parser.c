@@ -1,4 +1,5 @@
 #include "lem_in.h"
+#include <sys/mman.h>
 
 lem_in_parser_t *parser_create(void)
 {
@@ -9,27 +10,8 @@ lem_in_parser_t *parser_create(void)
 		return NULL;
 	}
 
-	parser->rooms = ft_calloc(MAX_ROOMS, sizeof(room_t));
-	if (!parser->rooms)
-	{
-		print_error(ERR_MEMORY, "rooms array");
-		return parser_destroy(parser);
-	}
-
-	parser->links = ft_calloc(MAX_LINKS, sizeof(link_t));
-	if (!parser->links)
-	{
-		print_error(ERR_MEMORY, "links array");
-		return parser_destroy(parser);
-	}
-
-	parser->hash_table = ft_calloc(HASH_SIZE, sizeof(hash_entry_t));
-	if (!parser->hash_table)
-	{
-		print_error(ERR_MEMORY, "hash table");
-		return parser_destroy(parser);
-	}
-
+	// Room, link and hash tables are allocated on first use and grow
+	// geometrically, so small maps only pay for what they contain
 	parser->start_room_id = INVALID_ROOM_ID;
 	parser->end_room_id = INVALID_ROOM_ID;
 	parser->ant_count = -1;
@@ -44,30 +26,33 @@ void *parser_destroy(lem_in_parser_t *parser)
 	if (!parser)
 		return NULL;
 
-	t_list *current = parser->file_content;
-	while (current)
-	{
-		t_list *next = current->next;
-		free(current->content);
-		free(current);
-		current = next;
-	}
-
-	free(parser->input_buffer);
-	free(parser->rooms);
+	if (parser->input_map_size)
+		munmap(parser->input_buffer, parser->input_map_size);
+	else
+		free(parser->input_buffer);
+	free(parser->nodes);
 	free(parser->links);
 	free(parser->hash_table);
+	free(parser->echo_spans);
 	free(parser);
 	return NULL;
 }
 
-static char *extract_line(char **line_ptr, char *end, char *saved_char)
+// Terminate the current line in place and advance past its line ending.
+// scan_line finds the ending and classifies the line on the way.
+// The overwritten byte is handed back so the caller can restore it once the
+// line has been processed, leaving the input buffer intact for the echo.
+// Unless this is the final chunk, a line is only complete once the byte
+// after its ending has arrived ("\r\n" may be split across two reads):
+// NULL is returned and nothing is touched until then.
+static char *extract_line(char **line_ptr, char *end, line_scan_t *scan, char *saved_char, bool final)
 {
 	char *line = *line_ptr;
-	char *line_end = line;
 
-	while (line_end < end && *line_end != '\n' && *line_end != '\r')
-		line_end++;
+	scan_line(line, end, scan);
+	char *line_end = scan->end;
+	if (!final && line_end + 1 >= end)
+		return NULL;
 
 	*saved_char = '\0';
 	if (line_end < end)
@@ -92,6 +77,39 @@ static char *extract_line(char **line_ptr, char *end, char *saved_char)
 	return line;
 }
 
+// Remember an accepted line for the echo. Lines separated by a single '\n'
+// are merged into the previous span, so a well-formed map is one span.
+static bool record_line(lem_in_parser_t *parser, const char *line, const char *line_end)
+{
+	size_t offset = (size_t)(line - parser->input_buffer);
+	size_t len = (size_t)(line_end - line);
+
+	if (parser->echo_count > 0)
+	{
+		span_t *last = &parser->echo_spans[parser->echo_count - 1];
+		size_t last_end = last->offset + last->len;
+		if (last_end + 1 == offset && parser->input_buffer[last_end] == '\n')
+		{
+			last->len += 1 + len;
+			return true;
+		}
+	}
+
+	if (parser->echo_count == parser->echo_capacity)
+	{
+		size_t capacity = parser->echo_capacity ? parser->echo_capacity * 2 : 16;
+		span_t *spans = realloc(parser->echo_spans, capacity * sizeof(span_t));
+		if (!spans)
+			return print_error(ERR_MEMORY, "echo spans");
+		parser->echo_spans = spans;
+		parser->echo_capacity = capacity;
+	}
+	parser->echo_spans[parser->echo_count].offset = offset;
+	parser->echo_spans[parser->echo_count].len = len;
+	parser->echo_count++;
+	return true;
+}
+
 static bool handle_command(char *line, int *next_flag)
 {
 	if (line[1] != '#')
@@ -115,49 +133,41 @@ static bool handle_command(char *line, int *next_flag)
 	return true;
 }
 
-static bool process_line(lem_in_parser_t *parser, char *line, int *next_flag, bool *found_ant_count)
+static bool process_line(lem_in_parser_t *parser, char *line, line_scan_t *scan)
 {
-	char *line_copy = ft_strdup(line);
-	if (!line_copy)
-		return print_error(ERR_MEMORY, "line duplication");
-
-	t_list *new_node = ft_lstnew(line_copy);
-	if (!new_node)
-	{
-		free(line_copy);
-		return print_error(ERR_MEMORY, "file content list");
-	}
-	ft_lstadd_back(&parser->file_content, new_node);
-
 	if (line[0] == '#')
-		return handle_command(line, next_flag);
+		return handle_command(line, &parser->next_flag);
 
-	if (!*found_ant_count)
+	if (!parser->found_ant_count)
 	{
 		error_code_t ant_error = ERR_NONE;
 		if (!validate_ant_count(line, &parser->ant_count, &ant_error))
 			return print_error(ant_error, line);
-		*found_ant_count = true;
+		parser->found_ant_count = true;
 		return true;
 	}
 
-	if (is_room_line(line))
+	// The checks read the line as a C string: a '\0' ends it early
+	if (scan->has_nul)
+		scan_line(line, line + ft_strlen(line), scan);
+
+	if (is_room_line(line, scan))
 	{
-		if (!parse_room_line(parser, line, *next_flag))
+		if (!parse_room_line(parser, line, scan, parser->next_flag))
 			return false;
-		*next_flag = 0;
+		parser->next_flag = 0;
 		return true;
 	}
 
-	if (ft_strchr(line, '-'))
-		return parse_link_line(parser, line);
+	if (scan->dash)
+		return parse_link_line(parser, line, scan);
 
 	return print_error(ERR_INVALID_LINE, line);
 }
 
-static bool validate_final_state(lem_in_parser_t *parser, bool found_ant_count)
+static bool validate_final_state(lem_in_parser_t *parser)
 {
-	if (!found_ant_count)
+	if (!parser->found_ant_count)
 		return print_error(ERR_EMPTY_INPUT, NULL);
 	if (!parser->has_start)
 		return print_error(ERR_NO_START, NULL);
@@ -168,34 +178,59 @@ static bool validate_final_state(lem_in_parser_t *parser, bool found_ant_count)
 	return true;
 }
 
-bool parse_input(lem_in_parser_t *parser)
+// Parse every complete line received so far. read_input calls this after
+// each read from a pipe, and parse_input once more with final set when the
+// whole input is there. The byte after the data is always writable.
+bool parse_chunk(lem_in_parser_t *parser, bool final)
 {
 	if (!parser || !parser->input_buffer)
 		return false;
+	if (parser->parse_done)
+		return true;
 
-	char *line = parser->input_buffer;
+	char *line = parser->input_buffer + parser->parse_offset;
 	char *end = parser->input_buffer + parser->input_size;
-	int next_flag = 0; // 0 = normal, 1 = ##start, 2 = ##end
-	bool found_ant_count = false;
 
+	if (final)
+		*end = '\0';
 	while (line < end)
 	{
+		char *next = line;
 		char saved_char = '\0';
+		line_scan_t scan;
 
-		char *current_line = extract_line(&line, end, &saved_char);
+		char *current_line = extract_line(&next, end, &scan, &saved_char, final);
+		if (!current_line)
+			break;
+		char *line_end = scan.end;
 
 		if (!*current_line)
 		{
-			if (!found_ant_count)
+			if (!parser->found_ant_count)
 				return print_error(ERR_EMPTY_INPUT, NULL);
+			*line_end = saved_char;
+			parser->parse_done = true;
 			break;
 		}
 
-		if (!process_line(parser, current_line, &next_flag, &found_ant_count))
+		if (!process_line(parser, current_line, &scan))
 			return false;
+		*line_end = saved_char;
+
+		if (!record_line(parser, current_line, line_end))
+			return false;
+		line = next;
 	}
+	parser->parse_offset = (size_t)(line - parser->input_buffer);
+	return true;
+}
+
+bool parse_input(lem_in_parser_t *parser)
+{
+	if (!parse_chunk(parser, true))
+		return false;
 
-	if (!validate_final_state(parser, found_ant_count))
+	if (!validate_final_state(parser))
 		return false;
 
 	return true;
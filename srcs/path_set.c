@@ -0,0 +1,122 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                               PATH SET
+ *
+ * Les chemins sont ranges bout a bout dans un seul tableau de salles ;
+ * offset[i] donne le debut du chemin i et offset[i + 1] sa fin. Vider
+ * l'ensemble garde les tampons, les reconstructions successives ne font
+ * donc plus d'allocation une fois la taille maximale atteinte.
+ *=========================================================================== */
+
+void path_set_init(t_path_set *set)
+{
+    set->rooms = NULL;
+    set->offset = NULL;
+    set->count = 0;
+    set->room_capacity = 0;
+    set->path_capacity = 0;
+}
+
+void path_set_clear(t_path_set *set)
+{
+    set->count = 0;
+}
+
+// commencer un nouveau chemin vide a la fin de l'ensemble
+int8_t path_set_open(t_path_set *set)
+{
+    size_t *offset;
+    size_t capacity;
+
+    if (set->count == set->path_capacity)
+    {
+        capacity = set->path_capacity ? set->path_capacity * 2 : 16;
+        if (!(offset = realloc(set->offset, (capacity + 1) * sizeof(size_t))))
+            return FAILURE;
+        set->offset = offset;
+        set->path_capacity = capacity;
+    }
+    if (set->count == 0)
+        set->offset[0] = 0;
+    set->offset[set->count + 1] = set->offset[set->count];
+    set->count++;
+    return SUCCESS;
+}
+
+// ajouter une salle au dernier chemin ouvert
+int8_t path_set_push(t_path_set *set, size_t room)
+{
+    uint32_t *rooms;
+    size_t capacity;
+    size_t end = set->offset[set->count];
+
+    if (end == set->room_capacity)
+    {
+        capacity = set->room_capacity ? set->room_capacity * 2 : 64;
+        if (!(rooms = realloc(set->rooms, capacity * sizeof(uint32_t))))
+            return FAILURE;
+        set->rooms = rooms;
+        set->room_capacity = capacity;
+    }
+    set->rooms[end] = room;
+    set->offset[set->count]++;
+    return SUCCESS;
+}
+
+// echanger deux ensembles sans recopier leurs chemins
+void path_set_swap(t_path_set *a, t_path_set *b)
+{
+    t_path_set tmp = *a;
+
+    *a = *b;
+    *b = tmp;
+}
+
+void path_set_free(t_path_set *set)
+{
+    free(set->rooms);
+    free(set->offset);
+    path_set_init(set);
+}
+
+static int8_t is_linked(const t_graph *graph, size_t from, size_t to)
+{
+    for (size_t e = graph->edge_offset[from]; e < graph->edge_offset[from + 1]; e++)
+    {
+        if (graph->edge_dest[e] == to)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// les count premiers chemins vont-ils de start a end par des liens du
+// graphe, sans partager de salle ? c'est ce que le solver suppose.
+// graph->room_used est remis a zero en sortie, sans parcourir tout le graphe
+int8_t path_set_is_valid(const t_graph *graph, const t_path_set *set, size_t count)
+{
+    const uint32_t *room;
+    uint8_t *used = graph->room_used;
+    size_t len;
+    int8_t valid = TRUE;
+
+    if (count == 0 || count > set->count)
+        return FALSE;
+    for (size_t i = 0; i < count && valid == TRUE; i++)
+    {
+        room = &set->rooms[set->offset[i]];
+        len = path_len(set, i);
+        if (len < 2 || room[0] != graph->start_room_id || room[len - 1] != graph->end_room_id)
+            valid = FALSE;
+        for (size_t k = 1; k < len && valid == TRUE; k++)
+        {
+            if (is_linked(graph, room[k - 1], room[k]) == FALSE
+                || (k + 1 < len && used[room[k]]))
+                valid = FALSE;
+            used[room[k]] = 1;
+        }
+    }
+    for (size_t k = set->offset[0]; k < set->offset[count]; k++)
+        used[set->rooms[k]] = 0;
+    return valid;
+}
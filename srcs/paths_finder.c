@@ -4,15 +4,11 @@
  *                               PATHS FINDER
  *=========================================================================== */
 
-int8_t is_new_solution_better(t_list *aug_paths, t_graph *graph)
+int8_t is_new_solution_better(const t_path_set *paths, t_graph *graph)
 {
-    t_paths *paths;
     size_t new_output_lines;
 
-    if ((paths = find_solution(graph, aug_paths)) == NULL)
-        return FAILURE;
-    new_output_lines = paths->output_lines;
-    free_paths(paths, graph);
+    new_output_lines = evaluate_output_lines(graph, paths);
     if (new_output_lines < graph->old_output_lines)
     {
         graph->old_output_lines = new_output_lines;
@@ -23,179 +19,211 @@ int8_t is_new_solution_better(t_list *aug_paths, t_graph *graph)
 
 int8_t is_source_neighbours(size_t node, t_graph *graph)
 {
-    t_edge *curr;
-
-    curr = graph->nodes[node].head;
-    while (curr != NULL)
+    for (size_t e = graph->edge_offset[node]; e < graph->edge_offset[node + 1]; e++)
     {
-        if (curr->dest == graph->start_room_id)
+        if (graph->edge_dest[e] == graph->start_room_id)
             return (TRUE);
-        curr = curr->next;
     }
     return (FALSE);
 }
 
-void skip_node(t_bfs *new_bfs, t_edge *neigh, t_graph *graph, t_list *path)
+// sauter sur un chemin existant et le remonter ; une salle deja atteinte
+// par ce bfs garde son prev, sinon prev pourrait boucler
+void skip_node(t_bfs *new_bfs, size_t neigh, t_graph *graph)
 {
-    t_edge *neigh2;
+    size_t dest = graph->edge_dest[neigh];
+    size_t dest2;
 
-    new_bfs->prev[neigh->dest] = new_bfs->node;
-    graph->nodes[neigh->dest].bfs_marked = TRUE;
-    graph->nodes[neigh->dest].enqueued = TRUE;
-    neigh2 = graph->nodes[neigh->dest].head;
-    while (neigh2)
+    new_bfs->prev[dest] = new_bfs->node;
+    mark_node(graph, dest);
+    graph->search.enqueue_stamp[dest] = graph->search.epoch;
+    for (size_t e = graph->edge_offset[dest]; e < graph->edge_offset[dest + 1]; e++)
     {
-        if (neigh2->capacity == 2
-            && is_on_path(neigh2->dest, path, graph) == TRUE
-            && neigh2->dest != graph->start_room_id)
-        {
-            enqueue(neigh->dest, neigh2->dest, graph, new_bfs);
-            graph->nodes[neigh2->dest].enqueued_backward = TRUE;
-        }
-        neigh2 = neigh2->next;
+        dest2 = graph->edge_dest[e];
+        if (graph->edge_capacity[e] == 2
+            && is_on_path(graph, dest2) == TRUE
+            && dest2 != graph->start_room_id
+            && graph->search.enqueue_stamp[dest2] != graph->search.epoch)
+            enqueue(dest, dest2, graph, new_bfs);
     }
 }
 
+// prev d'un noeud que ce bfs n'a pas atteint date d'une recherche passee
+static inline ssize_t reached_prev(t_bfs *new_bfs, size_t node)
+{
+    if (new_bfs->enqueue_stamp[node] != new_bfs->epoch)
+        return -1;
+    return new_bfs->prev[node];
+}
+
+// remonter prev[] depuis end ; le chemin n'existe que si on retombe sur start.
+// prev n'est ecrit qu'une fois par bfs, vers une salle atteinte avant : la
+// remontee se termine toujours
 t_bfs *reconstruct_path(t_bfs *new_bfs, t_graph *graph)
 {
-    t_list *tmp;
     ssize_t i;
-    size_t *dup;
+    size_t head;
+    size_t len;
 
-    i = graph->end_room_id;
-    while (i != -1)
+    len = 0;
+    head = graph->end_room_id;
+    for (i = graph->end_room_id; i != -1; i = reached_prev(new_bfs, i))
     {
-        if (!(dup = malloc(sizeof(size_t)))) return NULL;
-        *dup = i;
-        if ((tmp = ft_lstnew(dup)) == NULL) {
-            free(dup);
-            return (NULL);
-        }
-        ft_lstadd_front(&new_bfs->shortest_path, tmp);
-        i = new_bfs->prev[i];
+        head = i;
+        len++;
     }
-    if (!new_bfs->shortest_path || *(size_t *)new_bfs->shortest_path->content != graph->start_room_id)
+    if (head != graph->start_room_id)
     {
         reset_marks_fail(graph, new_bfs);
-        ft_lstclear(&new_bfs->shortest_path, del_content);
-        free_bfs(new_bfs);
         return (NULL);
     }
+    new_bfs->path_len = len;
+    for (i = graph->end_room_id; i != -1; i = reached_prev(new_bfs, i))
+        new_bfs->path[--len] = i;
     reset_marks(graph, new_bfs);
     return (new_bfs);
 }
 
-void enqueue_node(t_bfs *new_bfs, t_graph *graph, t_edge *neigh, t_list *path)
+void enqueue_node(t_bfs *new_bfs, t_graph *graph, size_t neigh)
 {
-    if (graph->nodes[neigh->dest].enqueued == FALSE)
+    size_t dest = graph->edge_dest[neigh];
+    uint8_t capacity = graph->edge_capacity[neigh];
+
+    if (graph->search.enqueue_stamp[dest] != graph->search.epoch)
     {
-        if (is_on_path(new_bfs->node, path, graph) == FALSE
+        if (is_on_path(graph, new_bfs->node) == FALSE
                 && new_bfs->node != graph->end_room_id)
         {
-            if (is_on_path(neigh->dest, path, graph) == TRUE
-                    && is_source_neighbours(neigh->dest, graph) == FALSE)
-                skip_node(new_bfs, neigh, graph, path);
-            else if (graph->nodes[neigh->dest].bfs_marked == FALSE)
-                enqueue(new_bfs->node, neigh->dest, graph, new_bfs);
+            if (is_on_path(graph, dest) == TRUE
+                    && is_source_neighbours(dest, graph) == FALSE)
+                skip_node(new_bfs, neigh, graph);
+            else if (is_marked(graph, dest) == FALSE)
+                enqueue(new_bfs->node, dest, graph, new_bfs);
         }
-        else if (is_on_path(new_bfs->node, path, graph) == TRUE
-                && ((neigh->capacity == 2 && neigh->dest != graph->start_room_id)
-                    || (neigh->capacity == 1
-                    && graph->nodes[neigh->dest].bfs_marked == FALSE)))
-            enqueue(new_bfs->node, neigh->dest, graph, new_bfs);
+        else if (is_on_path(graph, new_bfs->node) == TRUE
+                && ((capacity == 2 && dest != graph->start_room_id)
+                    || (capacity == 1
+                    && is_marked(graph, dest) == FALSE)))
+            enqueue(new_bfs->node, dest, graph, new_bfs);
     }
 }
 
-t_bfs *bfs(t_graph *graph, t_list *path)
+// path est l'index du chemin de paths a contourner (paths vaut NULL sinon)
+t_bfs *bfs(t_graph *graph, const t_path_set *paths, size_t path)
 {
     t_bfs *new_bfs;
-    t_edge *neigh;
 
-    neigh = NULL;
     if ((new_bfs = bfs_initializer(graph)) == NULL)
         return (NULL);
+    if (paths != NULL)
+        stamp_route(graph, paths, path);
+    graph->stats->bfs_calls++;
     while (new_bfs->queue_size > 0)
     {
         new_bfs->node = dequeue(new_bfs);
-        neigh = graph->nodes[new_bfs->node].head;
-        while (neigh != NULL)
-        {
-            enqueue_node(new_bfs, graph, neigh, path);
-            neigh = neigh->next;
-        }
+        graph->stats->edges_relaxed += graph->edge_offset[new_bfs->node + 1]
+            - graph->edge_offset[new_bfs->node];
+        for (size_t e = graph->edge_offset[new_bfs->node]; e < graph->edge_offset[new_bfs->node + 1]; e++)
+            enqueue_node(new_bfs, graph, e);
     }
     return (reconstruct_path(new_bfs, graph));
 }
 
-t_list *bfs_and_compare(t_graph *graph, t_list *aug_paths, t_list **path)
+// les chemins augmentes sont reconstruits dans candidate ; s'ils tiennent
+// (le contournement peut faire partager une salle a deux chemins) et sont
+// meilleurs on echange les deux ensembles, sinon on remet les capacites
+// et paths, qui n'a pas ete touche, reste l'ensemble courant
+int8_t bfs_and_compare(t_graph *graph, t_path_set *paths, t_path_set *candidate, size_t path)
 {
     t_bfs *new_bfs;
-    size_t path_pos;
 
-    path_pos = find_path_index(path, aug_paths, graph);
-    new_bfs = NULL;
-    if ((new_bfs = bfs(graph, *path)) == NULL)
-        return (aug_paths);
+    if ((new_bfs = bfs(graph, paths, path)) == NULL)
+        return (SUCCESS);
     update_capacity(graph, new_bfs, INCREASE);
-    ft_lstclear(&aug_paths, del_content);
-    aug_paths = rebuild_paths(graph);
-    if (is_new_solution_better(aug_paths, graph) == FALSE)
+    if (rebuild_paths(graph, candidate) == FAILURE)
+        return (FAILURE);
+    if (path_set_is_valid(graph, candidate, graph->paths_count) == TRUE
+        && is_new_solution_better(candidate, graph) == TRUE)
+    {
+        path_set_swap(paths, candidate);
+        graph->stats->augment_accepted++;
+    }
+    else
     {
         update_capacity(graph, new_bfs, DECREASE);
-        ft_lstclear(&aug_paths, del_content);
-        aug_paths = rebuild_paths(graph);
-        *path = aug_paths;
-        while (path_pos-- > 0)
-            *path = get_next_path(*path, graph);
+        graph->stats->augment_rejected++;
     }
-    ft_lstclear(&new_bfs->shortest_path, del_content);
-    free_bfs(new_bfs);
-    return (aug_paths);
+    return (SUCCESS);
 }
 
-t_list *first_bfs(t_graph *graph)
+int8_t first_bfs(t_graph *graph, t_path_set *paths)
 {
-    t_list *aug_paths;
     t_bfs *new_bfs;
-    t_paths *paths;
 
-    aug_paths = NULL;
-    if ((new_bfs = bfs(graph, NULL)) == NULL)
-        return (NULL);
-    ft_lstappend(&aug_paths, new_bfs->shortest_path);
-    update_capacity(graph, new_bfs, INCREASE);
-    if ((paths = find_solution(graph, aug_paths)) == NULL)
+    if ((new_bfs = bfs(graph, NULL, 0)) == NULL)
+        return (FAILURE);
+    path_set_clear(paths);
+    if (path_set_open(paths) == FAILURE)
+        return (FAILURE);
+    for (size_t k = 0; k < new_bfs->path_len; k++)
     {
-        ft_lstclear(&new_bfs->shortest_path, del_content);
-        free_bfs(new_bfs);
-        return (NULL);
+        if (path_set_push(paths, new_bfs->path[k]) == FAILURE)
+            return (FAILURE);
     }
-    graph->old_output_lines = paths->output_lines;
-    free_bfs(new_bfs);
-    free_paths(paths, graph);
-    return (aug_paths);
+    update_capacity(graph, new_bfs, INCREASE);
+    graph->old_output_lines = evaluate_output_lines(graph, paths);
+    return (SUCCESS);
 }
 
-t_list *find_paths(t_graph *graph)
+// on essaie de contourner chaque chemin tour a tour ; des qu'une
+// augmentation est acceptee on recommence au premier chemin. paths est
+// toujours le meilleur ensemble vu, on peut donc s'arreter des que le
+// budget est epuise ou que le minorant est atteint
+int8_t find_paths(t_graph *graph, t_path_set *paths)
 {
-    t_list *path;
-    t_list *aug_paths;
+    t_path_set candidate;
+    size_t path;
     size_t prev_paths_count;
-
-    if ((aug_paths = first_bfs(graph)) == NULL)
-        return (NULL);
-    path = aug_paths;
-    while (path != NULL)
+    int8_t status;
+
+    if (first_bfs(graph, paths) == FAILURE)
+        return (FAILURE);
+    path_set_init(&candidate);
+    status = SUCCESS;
+    path = 0;
+    while (path < paths->count && keep_searching(graph, graph->old_output_lines) == TRUE)
     {
         prev_paths_count = graph->paths_count;
-        aug_paths = bfs_and_compare(graph, aug_paths, &path);
+        if ((status = bfs_and_compare(graph, paths, &candidate, path)) == FAILURE)
+            break;
         if (prev_paths_count == graph->paths_count)
-        {
-            if ((path = get_next_path(path, graph)) == NULL)
-                return (aug_paths);
-        }
+            path++;
         else
-            path = aug_paths;
+            path = 0;
     }
-    return (aug_paths);
+    path_set_free(&candidate);
+    return (status);
+}
+
+// lancer le moteur de recherche choisi sur la ligne de commande, borne
+// par --budget / --budget-bfs s'ils sont donnes
+int8_t search_paths(t_graph *graph, const t_options *options, t_path_set *paths)
+{
+    t_budget budget;
+    int8_t status;
+
+    graph->lines_bound = lines_lower_bound(graph);
+    budget_start(&budget, options, graph->stats);
+    if (options->budget_ms || options->budget_bfs)
+        graph->budget = &budget;
+    if (options->engine == ENGINE_SPLIT)
+        status = find_paths_split(graph, paths);
+    else if (options->engine == ENGINE_MINCOST)
+        status = find_paths_mincost(graph, paths);
+    else if (options->engine == ENGINE_PORTFOLIO)
+        status = find_paths_portfolio(graph, paths);
+    else
+        status = find_paths(graph, paths);
+    graph->budget = NULL;
+    return (status);
 }
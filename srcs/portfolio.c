@@ -0,0 +1,116 @@
+#include "lem_in.h"
+#include <pthread.h>
+
+/*===========================================================================
+ *                               PORTFOLIO
+ *
+ * Tous les moteurs cherchent en meme temps et on garde l'ensemble de
+ * chemins qui donne le moins de tours. Le moteur heuristique modifie les
+ * capacites et l'espace de travail du graph, il tourne donc sur le thread
+ * appelant. Les autres ne font que lire le CSR : chacun recoit une copie
+ * de la structure t_graph avec sa propre arena et ses propres compteurs,
+ * les tableaux du graphe restent partages en lecture seule.
+ *=========================================================================== */
+
+typedef int8_t (*t_engine_fn)(t_graph *graph, t_path_set *paths);
+
+// moteurs lances sur un thread, dans l'ordre de preference en cas d'egalite
+static const t_engine_fn g_workers[] = {
+    find_paths_split,
+    find_paths_mincost,
+};
+
+#define WORKER_COUNT (sizeof(g_workers) / sizeof(g_workers[0]))
+
+typedef struct s_portfolio_run
+{
+    t_graph view;     // copie du graph, arena et compteurs a part
+    t_stats stats;
+    t_path_set paths;
+    t_engine_fn engine;
+    int8_t status;
+    pthread_t thread;
+    bool threaded;    // FALSE si le thread n'a pas pu etre cree
+} t_portfolio_run;
+
+static void *run_worker(void *arg)
+{
+    t_portfolio_run *run = arg;
+
+    run->status = run->engine(&run->view, &run->paths);
+    return NULL;
+}
+
+// sans thread disponible le moteur tourne tout de suite sur l'appelant
+static void start_worker(t_portfolio_run *run, t_graph *graph, t_engine_fn engine)
+{
+    run->view = *graph;
+    arena_init(&run->view.arena);
+    ft_bzero(&run->stats, sizeof(run->stats));
+    run->view.stats = &run->stats;
+    path_set_init(&run->paths);
+    run->engine = engine;
+    run->status = FAILURE;
+    run->threaded = pthread_create(&run->thread, NULL, run_worker, run) == 0;
+    if (run->threaded == FALSE)
+        run_worker(run);
+}
+
+// attendre le moteur et ajouter ses compteurs a ceux du graph
+static void join_worker(t_portfolio_run *run, t_stats *stats)
+{
+    if (run->threaded)
+        pthread_join(run->thread, NULL);
+    stats->bfs_calls += run->stats.bfs_calls;
+    stats->edges_relaxed += run->stats.edges_relaxed;
+    stats->augment_accepted += run->stats.augment_accepted;
+    stats->augment_rejected += run->stats.augment_rejected;
+    stats->arena_blocks += run->view.arena.allocations;
+    stats->budget_expired |= run->stats.budget_expired;
+    stats->early_stop |= run->stats.early_stop;
+    arena_release(&run->view.arena);
+}
+
+// un moteur qui a echoue ou dont les chemins ne tiennent pas (le moteur
+// heuristique en sort parfois qui se croisent) ne peut pas gagner
+static size_t run_lines(int8_t status, const t_graph *graph, const t_path_set *paths)
+{
+    if (status != SUCCESS || path_set_is_valid(graph, paths, graph->paths_count) == FALSE)
+        return SIZE_MAX;
+    return graph->old_output_lines;
+}
+
+// paths et graph gardent le resultat de l'heuristique, sauf si un autre
+// moteur fait au moins aussi bien : on reprend alors ses chemins
+int8_t find_paths_portfolio(t_graph *graph, t_path_set *paths)
+{
+    t_portfolio_run runs[WORKER_COUNT];
+    t_portfolio_run *best = NULL;
+    size_t best_lines = SIZE_MAX;
+    size_t lines;
+    int8_t status;
+
+    for (size_t i = 0; i < WORKER_COUNT; i++)
+        start_worker(&runs[i], graph, g_workers[i]);
+    status = find_paths(graph, paths);
+    for (size_t i = 0; i < WORKER_COUNT; i++)
+    {
+        join_worker(&runs[i], graph->stats);
+        lines = run_lines(runs[i].status, &runs[i].view, &runs[i].paths);
+        if (lines < best_lines)
+        {
+            best = &runs[i];
+            best_lines = lines;
+        }
+    }
+    if (best != NULL && best_lines <= run_lines(status, graph, paths))
+    {
+        path_set_swap(paths, &best->paths);
+        graph->paths_count = best->view.paths_count;
+        graph->old_output_lines = best->view.old_output_lines;
+        status = SUCCESS;
+    }
+    for (size_t i = 0; i < WORKER_COUNT; i++)
+        path_set_free(&runs[i].paths);
+    return (status);
+}
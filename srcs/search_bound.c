@@ -0,0 +1,89 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                         ARRET DE LA RECHERCHE
+ *
+ * Un chemin qui part de start par le voisin v fait au moins
+ * 1 + dist(v, end) liens, et des chemins disjoints partent par des voisins
+ * differents. Le water-fill de count_output_lines sur ces longueurs
+ * minimales donne donc un minorant du nombre de tours de n'importe quel
+ * ensemble de chemins ; idem depuis end. Des qu'un moteur l'atteint,
+ * plus aucune augmentation ne peut l'ameliorer. Avec une seule fourmi,
+ * le premier plus court chemin suffit.
+ *=========================================================================== */
+
+// distance en liens de chaque salle a target, UINT32_MAX si injoignable
+static void distances_to(t_graph *graph, size_t target, uint32_t *dist, uint32_t *queue)
+{
+    size_t front = 0, rear = 0;
+    uint32_t node;
+
+    for (size_t v = 0; v < graph->size; v++)
+        dist[v] = UINT32_MAX;
+    dist[target] = 0;
+    queue[rear++] = (uint32_t)target;
+    while (front < rear)
+    {
+        node = queue[front++];
+        for (size_t e = graph->edge_offset[node]; e < graph->edge_offset[node + 1]; e++)
+        {
+            if (dist[graph->edge_dest[e]] != UINT32_MAX)
+                continue;
+            dist[graph->edge_dest[e]] = dist[node] + 1;
+            queue[rear++] = graph->edge_dest[e];
+        }
+    }
+}
+
+static size_t degree(const t_graph *graph, size_t room)
+{
+    return graph->edge_offset[room + 1] - graph->edge_offset[room];
+}
+
+// minorant vu depuis from : une longueur minimale par voisin de from
+static size_t bound_from(t_graph *graph, size_t from, size_t to, uint32_t *dist, uint32_t *queue,
+    size_t *len)
+{
+    size_t count = 0;
+
+    distances_to(graph, to, dist, queue);
+    for (size_t e = graph->edge_offset[from]; e < graph->edge_offset[from + 1]; e++)
+    {
+        if (dist[graph->edge_dest[e]] != UINT32_MAX)
+            len[count++] = 1 + (size_t)dist[graph->edge_dest[e]];
+    }
+    return count ? count_output_lines(len, count, graph->ants) : 0;
+}
+
+// 0 (aucun arret anticipe) si la memoire manque
+size_t lines_lower_bound(t_graph *graph)
+{
+    t_arena_mark mark = arena_mark(&graph->arena);
+    uint32_t *dist = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t));
+    uint32_t *queue = arena_alloc(&graph->arena, graph->size * sizeof(uint32_t));
+    size_t *len = arena_alloc(&graph->arena, (degree(graph, graph->start_room_id)
+        + degree(graph, graph->end_room_id) + 1) * sizeof(size_t));
+    size_t from_start = 0, from_end = 0;
+
+    if (dist && queue && len)
+    {
+        from_start = bound_from(graph, graph->start_room_id, graph->end_room_id, dist, queue, len);
+        from_end = bound_from(graph, graph->end_room_id, graph->start_room_id, dist, queue, len);
+    }
+    arena_rewind(&graph->arena, mark);
+    return from_start > from_end ? from_start : from_end;
+}
+
+// a tester avant chaque augmentation : tant qu'aucun ensemble n'est trouve
+// on continue, ensuite on s'arrete sur le minorant ou le budget
+int8_t keep_searching(t_graph *graph, size_t best_lines)
+{
+    if (best_lines == SIZE_MAX)
+        return TRUE;
+    if (best_lines <= graph->lines_bound)
+    {
+        graph->stats->early_stop = 1;
+        return FALSE;
+    }
+    return budget_exhausted(graph->budget, graph->stats) == false;
+}
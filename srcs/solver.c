@@ -1,10 +1,41 @@
 #include "lem_in.h"
 #include <stddef.h>
 
-int8_t is_solution_found(t_paths *paths, t_graph *graph)
+static int compare_lengths(const void *a, const void *b)
 {
-    size_t i = 0, sum = 0;
-    while (i < graph->paths_count)
+    size_t la = *(const size_t *)a;
+    size_t lb = *(const size_t *)b;
+
+    return (la > lb) - (la < lb);
+}
+
+// nombre de tours minimal pour faire passer toutes les fourmis par des
+// chemins de longueurs len[] (water-fill sur les longueurs triees).
+// avec m chemins actifs de longueurs L1..Lm, T tours laissent passer
+// m * (T + 1) - (L1 + ... + Lm) fourmis ; on cherche le plus petit m pour
+// lequel le chemin m+1 n'apporterait rien. len[] est trie sur place.
+size_t count_output_lines(size_t *len, size_t count, size_t ants)
+{
+    size_t sum = 0, lines = 0;
+
+    qsort(len, count, sizeof(size_t), compare_lengths);
+    if (len[0] == 1)
+        return 1;
+    for (size_t m = 1; m <= count; m++)
+    {
+        sum += len[m - 1];
+        lines = (ants + sum + m - 1) / m - 1;
+        if (m == count || lines <= len[m] - 1)
+            break;
+    }
+    return lines;
+}
+
+// repartition des fourmis pour paths->output_lines tours : chaque chemin
+// en accepte autant que de tours restants une fois sa longueur parcourue
+static void set_ants_per_path(t_paths *paths, t_graph *graph)
+{
+    for (size_t i = 0; i < graph->paths_count; i++)
     {
         if (paths->output_lines < paths->len[i] - 1)
             paths->n[i] = 0;
@@ -12,121 +43,107 @@ int8_t is_solution_found(t_paths *paths, t_graph *graph)
             paths->n[i] = graph->ants;
         else
             paths->n[i] = paths->output_lines - paths->len[i] + 1;
-        i++;
     }
-    i = 0;
-    while (i < graph->paths_count)
-        sum += paths->n[i++];
-    if (sum >= graph->ants)
-        return TRUE;
-    return FALSE;
 }
 
-t_paths *find_solution(t_graph *graph, t_list *aug_paths)
+// nombre de tours d'un ensemble de chemins sans construire de t_paths ;
+// les longueurs sont prises au sommet de l'arena du graph, pas sur la pile
+// (le nombre de chemins n'est borne que par le degre de start)
+size_t evaluate_output_lines(t_graph *graph, const t_path_set *set)
+{
+    size_t count = set->count < graph->paths_count ? set->count : graph->paths_count;
+    t_arena_mark mark;
+    size_t *len;
+    size_t lines;
+
+    if (count == 0)
+        return SIZE_MAX;
+    mark = arena_mark(&graph->arena);
+    if ((len = arena_alloc(&graph->arena, count * sizeof(size_t))) == NULL)
+        return SIZE_MAX;
+    for (size_t i = 0; i < count; i++)
+        len[i] = path_len(set, i) - 1;
+    lines = count_output_lines(len, count, graph->ants);
+    arena_rewind(&graph->arena, mark);
+    return lines;
+}
+
+t_paths *find_solution(t_graph *graph, const t_path_set *set)
 {
     t_paths *paths;
-    size_t i = 0;
 
-    if ((paths = init_output(graph, aug_paths)) == NULL)
+    if ((paths = init_output(graph, set)) == NULL)
         return NULL;
 
-    init_lines(paths, graph);
-    while (is_solution_found(paths, graph) == FALSE)
+    if (graph->paths_count)
     {
-        i = 0;
-        while (i < graph->paths_count)
-            paths->n[i++] = 0;
-        paths->output_lines++;
-    }
-    if (graph->paths_count && !(paths->available = malloc(sizeof(int8_t) * graph->paths_count)))
-    {
-        free_paths(paths, graph);
-        return NULL;
+        // paths->n sert de tampon pour le tri avant d'etre rempli
+        ft_memcpy(paths->n, paths->len, graph->paths_count * sizeof(size_t));
+        paths->output_lines = count_output_lines(paths->n, graph->paths_count, graph->ants);
+        set_ants_per_path(paths, graph);
     }
     return paths;
 }
 
-static int8_t reset_availability(t_graph *graph, t_paths *paths, size_t *ants_to_paths)
+// fourmis envoyees pendant les rounds premiers rounds du planning
+static size_t ants_in_rounds(const size_t *capacity, size_t count, size_t rounds)
 {
-    for (size_t i = 0; i < graph->paths_count; i++)
-    {
-        paths->available[i] = ants_to_paths[i] > 0 ? TRUE : FALSE;
-    }
-    return (SUCCESS);
-}
+    size_t sum = 0;
 
-static size_t update_index(t_graph *graph, t_paths *paths, size_t *ants_to_paths, size_t j)
-{
-    if (j == graph->paths_count - 1 && paths->available[j] == FALSE)
-    {
-        reset_availability(graph, paths, ants_to_paths);
-        j = 0;
-    }
-    else
-        j++;
-    return j;
+    for (size_t j = 0; j < count; j++)
+        sum += capacity[j] < rounds ? capacity[j] : rounds;
+    return sum;
 }
 
-static void update_n(t_graph *graph, t_paths *paths, size_t *tmp)
+// planning des fourmis, sans rien stocker par fourmi : a chaque round,
+// chaque chemin qui a encore de la place recoit la fourmi suivante, dans
+// l'ordre des chemins. la fourmi de rang r sur un chemin part donc au
+// tour r + 1 et son numero se deduit du round (voir display_lines).
+// on cherche le nombre de rounds complets, le dernier round partiel
+// servant les premiers chemins encore ouverts. en entree n[] est la
+// capacite de chaque chemin, en sortie le nombre de fourmis envoyees
+void assign_ants_to_paths(t_graph *graph, t_paths *paths)
 {
-    for (size_t i = 0; i < graph->paths_count; i++)
+    size_t lo = 0, hi = 0, mid, rest;
+
+    for (size_t j = 0; j < graph->paths_count; j++)
     {
-        paths->n[i] = paths->n[i] - tmp[i];
+        if (paths->n[j] > hi)
+            hi = paths->n[j];
     }
-    reset_availability(graph, paths, paths->n);
-}
-
-static void all_paths_used(t_graph *graph, t_paths *paths, size_t *tmp)
-{
-    for (size_t i = 0; i < graph->paths_count; i++)
+    while (lo < hi)
     {
-        if (paths->n[i] > 0 && paths->available[i] == TRUE)
-            return ;   
+        mid = lo + (hi - lo + 1) / 2;
+        if (ants_in_rounds(paths->n, graph->paths_count, mid) <= graph->ants)
+            lo = mid;
+        else
+            hi = mid - 1;
     }
-    reset_availability(graph, paths, tmp);
-}   
-
-void assign_ants_to_paths(t_graph *graph, t_paths *paths, size_t *tmp)
-{
-    size_t j;
-
-    for (size_t i = 0; i < graph->ants; i++)
+    rest = graph->ants - ants_in_rounds(paths->n, graph->paths_count, lo);
+    for (size_t j = 0; j < graph->paths_count; j++)
     {
-        all_paths_used(graph, paths, tmp);
-        j = 0;
-        while (j < graph->paths_count)
+        if (paths->n[j] > lo)
         {
-            if (tmp[j] == 0)
-                paths->available[j] = FALSE;
-            if (paths->available[j] == TRUE && tmp[j] > 0)
+            paths->n[j] = lo;
+            if (rest > 0)
             {
-                paths->ants_to_paths[i] = j;
-                tmp[j]--;
-                paths->available[j] = FALSE;
-                break ;
+                paths->n[j]++;
+                rest--;
             }
-            j = update_index(graph, paths, tmp, j);
         }
     }
-    update_n(graph, paths, tmp);
 }
 
-int8_t solver(t_graph *graph, t_list *aug_paths)
+int8_t solver(t_graph *graph, const t_path_set *set)
 {
     t_paths *paths;
-    size_t i = 0, tmp[graph->paths_count];
+    int8_t status;
 
-    if ((paths = find_solution(graph, aug_paths)) == NULL)
+    if ((paths = find_solution(graph, set)) == NULL)
         return FAILURE;
-    
-    while (i < graph->paths_count)
-    {
-        tmp[i] = paths->n[i];
-        i++;
-    }
-    reset_availability(graph, paths, paths->n);
-    assign_ants_to_paths(graph, paths, tmp);
-    display_lines(paths, graph);
-    free_paths(paths, graph);
-    return SUCCESS;
-}
\ No newline at end of file
+    assign_ants_to_paths(graph, paths);
+    stats_lap(graph->stats, STAGE_FIND_SOLUTION);
+    status = display_lines(paths, graph);
+    stats_lap(graph->stats, STAGE_DISPLAY);
+    return status;
+}
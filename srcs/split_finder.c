@@ -0,0 +1,373 @@
+#include "lem_in.h"
+
+/*===========================================================================
+ *                         VERTEX-SPLIT PATHS FINDER
+ *
+ * Chaque salle v devient deux noeuds v_in (2v) et v_out (2v + 1) relies
+ * par un arc de capacite 1 : un chemin augmentant ne peut donc traverser
+ * une salle qu'une seule fois, sans aucune verification de chemin pendant
+ * le bfs. Chaque lien u-v donne les arcs u_out -> v_in et v_out -> u_in.
+ * Tous les arcs ont un jumeau residuel de capacite 0.
+ *
+ * Un couloir a..b (graph_reduce.c) se traverse en entier ou pas du tout :
+ * il devient les deux arcs a_out -> b_in et b_out -> a_in, qui comptent
+ * pour tous ses liens, et ses salles n'ont plus d'arc. Les chemins tires
+ * du flot remettent ses salles dans l'ordre du parcours.
+ *=========================================================================== */
+
+#define NO_ENTRY UINT32_MAX
+
+// reserver un arc et son jumeau residuel
+static void add_arc(t_split_graph *split, uint32_t *cursor, size_t from, size_t to,
+    uint32_t links, uint32_t via)
+{
+    uint32_t forward = cursor[from]++;
+    uint32_t backward = cursor[to]++;
+
+    split->dest[forward] = to;
+    split->capacity[forward] = 1;
+    split->forward[forward] = TRUE;
+    split->twin[forward] = backward;
+    split->dest[backward] = from;
+    split->capacity[backward] = 0;
+    split->forward[backward] = FALSE;
+    split->twin[backward] = forward;
+    split->links[forward] = split->links[backward] = links;
+    split->via[forward] = split->via[backward] = via;
+}
+
+// l'autre bout du couloir c vu de la salle room, room elle-meme si room
+// est dans le couloir ou si le couloir revient sur room
+static size_t corridor_exit(const t_graph *graph, uint32_t c, size_t room)
+{
+    const t_corridors *cor = &graph->corridors;
+
+    if (cor->end_a[c] == room)
+        return cor->end_b[c];
+    if (cor->end_b[c] == room)
+        return cor->end_a[c];
+    return room;
+}
+
+// tout le graphe divise est pris dans l'arena du graph, au-dessus de mark
+static int8_t split_allocate(t_split_graph *split, t_graph *graph)
+{
+    t_arena *arena = &graph->arena;
+
+    split->arena = arena;
+    split->stats = graph->stats;
+    split->mark = arena_mark(arena);
+    split->node_count = graph->size * 2;
+    split->arc_count = 2 * (graph->size + graph->edge_count);
+    // l'arc le plus long, un couloir de n salles, vaut 2n + 1 arcs
+    split->bucket_count = 2;
+    for (size_t c = 0; c < graph->corridors.count; c++)
+    {
+        size_t rooms = graph->corridors.first[c + 1] - graph->corridors.first[c];
+        if (2 * rooms + 2 > split->bucket_count)
+            split->bucket_count = (uint32_t)(2 * rooms + 2);
+    }
+    split->offset = arena_calloc(arena, split->node_count + 1, sizeof(uint32_t));
+    split->dest = arena_alloc(arena, split->arc_count * sizeof(uint32_t));
+    split->twin = arena_alloc(arena, split->arc_count * sizeof(uint32_t));
+    split->capacity = arena_alloc(arena, split->arc_count);
+    split->forward = arena_alloc(arena, split->arc_count);
+    split->links = arena_alloc(arena, split->arc_count * sizeof(uint32_t));
+    split->via = arena_alloc(arena, split->arc_count * sizeof(uint32_t));
+    split->dist = arena_alloc(arena, split->node_count * sizeof(uint32_t));
+    split->bucket_head = arena_alloc(arena, split->bucket_count * sizeof(uint32_t));
+    split->bucket_tail = arena_alloc(arena, split->bucket_count * sizeof(uint32_t));
+    split->entry_node = arena_alloc(arena, (split->arc_count + 1) * sizeof(uint32_t));
+    split->entry_next = arena_alloc(arena, (split->arc_count + 1) * sizeof(uint32_t));
+    split->prev_arc = arena_alloc(arena, split->node_count * sizeof(uint32_t));
+    split->visited = arena_calloc(arena, split->node_count, sizeof(uint32_t));
+    split->epoch = 0;
+    if (!split->offset || !split->dest || !split->twin || !split->capacity || !split->forward
+        || !split->links || !split->via || !split->dist || !split->bucket_head
+        || !split->bucket_tail || !split->entry_node || !split->entry_next
+        || !split->prev_arc || !split->visited)
+        return FAILURE;
+    return SUCCESS;
+}
+
+void split_destroy(t_split_graph *split)
+{
+    arena_rewind(split->arena, split->mark);
+}
+
+// la salle ou mene le passage e de v dans le graphe divise, v si le
+// passage n'y donne aucun arc
+static size_t edge_target(const t_graph *graph, size_t v, size_t e)
+{
+    uint32_t c = graph->corridors.edge_corridor[e];
+
+    if (c == NO_CORRIDOR)
+        return graph->edge_dest[e];
+    return corridor_exit(graph, c, v);
+}
+
+// construire le graphe residuel une seule fois a partir du CSR des salles
+int8_t split_build(t_split_graph *split, t_graph *graph)
+{
+    uint32_t *cursor;
+    t_arena_mark mark;
+
+    if (split_allocate(split, graph) == FAILURE)
+        return FAILURE;
+    // v_in : arc interne + un jumeau par lien entrant, idem pour v_out
+    for (size_t v = 0; v < graph->size; v++)
+    {
+        size_t degree = 0;
+        for (size_t e = graph->edge_offset[v]; e < graph->edge_offset[v + 1]; e++)
+            degree += edge_target(graph, v, e) != v;
+        split->offset[SPLIT_IN(v) + 1] = 1 + degree;
+        split->offset[SPLIT_OUT(v) + 1] = 1 + degree;
+    }
+    for (size_t n = 0; n < split->node_count; n++)
+        split->offset[n + 1] += split->offset[n];
+    mark = arena_mark(split->arena);
+    if ((cursor = arena_alloc(split->arena, split->node_count * sizeof(uint32_t))) == NULL)
+        return FAILURE;
+    ft_memcpy(cursor, split->offset, split->node_count * sizeof(uint32_t));
+    for (size_t v = 0; v < graph->size; v++)
+    {
+        add_arc(split, cursor, SPLIT_IN(v), SPLIT_OUT(v), 0, NO_CORRIDOR);
+        for (size_t e = graph->edge_offset[v]; e < graph->edge_offset[v + 1]; e++)
+        {
+            size_t to = edge_target(graph, v, e);
+            uint32_t c = graph->corridors.edge_corridor[e];
+
+            if (to == v)
+                continue;
+            if (c == NO_CORRIDOR)
+                add_arc(split, cursor, SPLIT_OUT(v), SPLIT_IN(to), 1, NO_CORRIDOR);
+            else
+                add_arc(split, cursor, SPLIT_OUT(v), SPLIT_IN(to),
+                    graph->corridors.first[c + 1] - graph->corridors.first[c] + 1, c);
+        }
+    }
+    arena_rewind(split->arena, mark);
+    split->source = SPLIT_OUT(graph->start_room_id);
+    split->sink = SPLIT_IN(graph->end_room_id);
+    return SUCCESS;
+}
+
+// longueur d'un arc en arcs du graphe divise sans couloir : un couloir de
+// n salles en compte 2n + 1
+static inline uint32_t arc_hops(const t_split_graph *split, uint32_t a)
+{
+    return split->links[a] ? 2 * split->links[a] - 1 : 1;
+}
+
+// ajouter node a la file de la distance dist
+static void bucket_push(t_split_graph *split, uint32_t *entries, uint32_t node, uint32_t dist)
+{
+    uint32_t b = dist % split->bucket_count;
+    uint32_t i = (*entries)++;
+
+    split->entry_node[i] = node;
+    split->entry_next[i] = NO_ENTRY;
+    if (split->bucket_head[b] == NO_ENTRY)
+        split->bucket_head[b] = i;
+    else
+        split->entry_next[split->bucket_tail[b]] = i;
+    split->bucket_tail[b] = i;
+}
+
+// plus court chemin de start_out a end_in sur les arcs de capacite
+// residuelle positive, en arcs du graphe sans couloir. Une file par
+// distance, modulo l'arc le plus long (Dial) : sans couloir c'est le bfs,
+// dans le meme ordre. Un noeud n'est pousse que s'il se rapproche, chaque
+// arc pousse donc au plus une entree
+static int8_t split_bfs(t_split_graph *split)
+{
+    uint32_t entries = 0, pending = 1, dist = 0;
+    uint32_t i, node, next, reach;
+
+    split->epoch++;
+    split->stats->bfs_calls++;
+    for (uint32_t b = 0; b < split->bucket_count; b++)
+        split->bucket_head[b] = NO_ENTRY;
+    split->visited[split->source] = split->epoch;
+    split->dist[split->source] = 0;
+    bucket_push(split, &entries, (uint32_t)split->source, 0);
+    for (; pending > 0; dist++)
+    {
+        while ((i = split->bucket_head[dist % split->bucket_count]) != NO_ENTRY)
+        {
+            split->bucket_head[dist % split->bucket_count] = split->entry_next[i];
+            pending--;
+            node = split->entry_node[i];
+            if (split->dist[node] != dist)
+                continue;
+            if (node == split->sink)
+                return TRUE;
+            split->stats->edges_relaxed += split->offset[node + 1] - split->offset[node];
+            for (uint32_t a = split->offset[node]; a < split->offset[node + 1]; a++)
+            {
+                next = split->dest[a];
+                reach = dist + arc_hops(split, a);
+                if (split->capacity[a] == 0
+                    || (split->visited[next] == split->epoch && split->dist[next] <= reach))
+                    continue;
+                split->visited[next] = split->epoch;
+                split->dist[next] = reach;
+                split->prev_arc[next] = a;
+                // rien ne peut plus arriver avant dist + 1
+                if (next == split->sink && reach == dist + 1)
+                    return TRUE;
+                bucket_push(split, &entries, next, reach);
+                pending++;
+            }
+        }
+    }
+    return FALSE;
+}
+
+// faire passer une unite de flot le long du chemin trouve par le bfs
+void split_augment(t_split_graph *split)
+{
+    size_t node = split->sink;
+    uint32_t a;
+
+    while (node != split->source)
+    {
+        a = split->prev_arc[node];
+        split->capacity[a]--;
+        split->capacity[split->twin[a]]++;
+        node = split->dest[split->twin[a]];
+    }
+}
+
+// l'arc de flot qui quitte room_out : chaque salle traversee par le flot
+// en porte exactement une unite, la boucle s'arrete donc toujours
+static uint32_t next_flow_arc(t_split_graph *split, size_t room)
+{
+    uint32_t a = split->offset[SPLIT_OUT(room)];
+
+    while (!split->forward[a] || split->capacity[a] != 0)
+        a++;
+    return a;
+}
+
+// longueurs des chemins portes par le flot courant, couloirs compris
+size_t split_flow_lengths(t_split_graph *split, t_graph *graph, size_t *len)
+{
+    size_t count = 0;
+    size_t room;
+
+    for (uint32_t a = split->offset[split->source]; a < split->offset[split->source + 1]; a++)
+    {
+        if (!split->forward[a] || split->capacity[a] != 0)
+            continue;
+        room = SPLIT_ROOM(split->dest[a]);
+        len[count] = split->links[a];
+        while (room != graph->end_room_id)
+        {
+            uint32_t next = next_flow_arc(split, room);
+            len[count] += split->links[next];
+            room = SPLIT_ROOM(split->dest[next]);
+        }
+        count++;
+    }
+    return count;
+}
+
+// les salles du couloir que l'arc a traverse, dans le sens du parcours
+static int8_t push_corridor(t_split_graph *split, t_graph *graph, uint32_t a,
+    t_path_set *paths)
+{
+    const t_corridors *cor = &graph->corridors;
+    uint32_t c = split->via[a];
+
+    if (c == NO_CORRIDOR)
+        return SUCCESS;
+    if (cor->end_a[c] == SPLIT_ROOM(split->dest[split->twin[a]]))
+    {
+        for (uint32_t k = cor->first[c]; k < cor->first[c + 1]; k++)
+            if (path_set_push(paths, cor->rooms[k]) == FAILURE)
+                return FAILURE;
+        return SUCCESS;
+    }
+    for (uint32_t k = cor->first[c + 1]; k > cor->first[c]; k--)
+        if (path_set_push(paths, cor->rooms[k - 1]) == FAILURE)
+            return FAILURE;
+    return SUCCESS;
+}
+
+// ajouter a l'ensemble le chemin qui commence par l'arc start_out -> v_in
+static int8_t append_flow_path(t_split_graph *split, t_graph *graph, uint32_t a,
+    t_path_set *paths)
+{
+    size_t room = SPLIT_ROOM(split->dest[a]);
+
+    if (path_set_open(paths) == FAILURE
+        || path_set_push(paths, graph->start_room_id) == FAILURE
+        || push_corridor(split, graph, a, paths) == FAILURE)
+        return FAILURE;
+    while (room != graph->end_room_id)
+    {
+        if (path_set_push(paths, room) == FAILURE)
+            return FAILURE;
+        a = next_flow_arc(split, room);
+        if (push_corridor(split, graph, a, paths) == FAILURE)
+            return FAILURE;
+        room = SPLIT_ROOM(split->dest[a]);
+    }
+    return path_set_push(paths, room);
+}
+
+// convertir le flot courant en ensemble de chemins
+int8_t split_flow_to_paths(t_split_graph *split, t_graph *graph, t_path_set *paths)
+{
+    path_set_clear(paths);
+    for (uint32_t a = split->offset[split->source]; a < split->offset[split->source + 1]; a++)
+    {
+        if (!split->forward[a] || split->capacity[a] != 0)
+            continue;
+        if (append_flow_path(split, graph, a, paths) == FAILURE)
+            return FAILURE;
+    }
+    return SUCCESS;
+}
+
+// Edmonds-Karp sur le graphe divise : apres chaque augmentation on evalue
+// le nombre de tours du flot courant et on garde le meilleur ensemble,
+// jusqu'a ce que keep_searching dise stop
+int8_t find_paths_split(t_graph *graph, t_path_set *paths)
+{
+    t_split_graph split;
+    size_t best_lines = SIZE_MAX, best_count = 0;
+    size_t *len, count, lines;
+
+    if (split_build(&split, graph) == FAILURE
+        || !(len = arena_alloc(&graph->arena, (graph->edge_offset[graph->start_room_id + 1]
+            - graph->edge_offset[graph->start_room_id] + 1) * sizeof(size_t))))
+    {
+        split_destroy(&split);
+        return FAILURE;
+    }
+    while (keep_searching(graph, best_lines) == TRUE && split_bfs(&split) == TRUE)
+    {
+        split_augment(&split);
+        count = split_flow_lengths(&split, graph, len);
+        lines = count_output_lines(len, count, graph->ants);
+        if (lines < best_lines)
+        {
+            if (split_flow_to_paths(&split, graph, paths) == FAILURE)
+            {
+                best_count = 0;
+                break;
+            }
+            best_lines = lines;
+            best_count = count;
+            graph->stats->augment_accepted++;
+        }
+        else
+            graph->stats->augment_rejected++;
+    }
+    split_destroy(&split);
+    graph->paths_count = best_count;
+    graph->old_output_lines = best_lines;
+    return best_count ? SUCCESS : FAILURE;
+}
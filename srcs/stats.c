@@ -0,0 +1,160 @@
+#define _DEFAULT_SOURCE // clock_gettime, getrusage
+#include "lem_in.h"
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <time.h>
+
+static const char *g_stage_names[STAGE_COUNT] = {
+	[STAGE_READ_INPUT] = "read_input",
+	[STAGE_PARSE_INPUT] = "parse_input",
+	[STAGE_GRAPH_BUILDER] = "graph_builder",
+	[STAGE_CHECK_PATH] = "check_path",
+	[STAGE_FIND_PATHS] = "find_paths",
+	[STAGE_FIND_SOLUTION] = "find_solution",
+	[STAGE_DISPLAY] = "display",
+};
+
+static uint64_t clock_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void stats_start(t_stats *stats)
+{
+	ft_bzero(stats, sizeof(*stats));
+	stats->since = clock_ns();
+}
+
+// Charge the time since the previous lap to `stage`. A stage may be
+// entered several times (the echo and the moves both count as display).
+void stats_lap(t_stats *stats, t_stage stage)
+{
+	uint64_t now = clock_ns();
+
+	stats->stage_ns[stage] += now - stats->since;
+	stats->since = now;
+}
+
+// Both limits count from the start of the path search
+void budget_start(t_budget *budget, const t_options *options, const t_stats *stats)
+{
+	budget->deadline_ns = 0;
+	if (options->budget_ms)
+		budget->deadline_ns = clock_ns() + (uint64_t)options->budget_ms * 1000000ull;
+	budget->bfs_base = stats->bfs_calls;
+	budget->max_bfs = options->budget_bfs;
+}
+
+// Checked between augmentations, a clock read each time is negligible
+// next to a bfs. A NULL budget never runs out.
+bool budget_exhausted(const t_budget *budget, t_stats *stats)
+{
+	if (!budget)
+		return false;
+	if ((budget->max_bfs && stats->bfs_calls - budget->bfs_base >= budget->max_bfs)
+		|| (budget->deadline_ns && clock_ns() >= budget->deadline_ns))
+	{
+		stats->budget_expired = 1;
+		return true;
+	}
+	return false;
+}
+
+// Milliseconds with three decimals, without going through floating point
+static void write_ms(t_writer *out, uint64_t ns)
+{
+	uint64_t us = ns / 1000;
+
+	writer_number(out, us / 1000);
+	writer_char(out, '.');
+	writer_char(out, '0' + (us / 100) % 10);
+	writer_char(out, '0' + (us / 10) % 10);
+	writer_char(out, '0' + us % 10);
+}
+
+static void write_field(t_writer *out, const char *name, bool json, bool first)
+{
+	size_t len = ft_strlen(name);
+
+	if (!json)
+	{
+		writer_str(out, name, len);
+		for (size_t pad = len; pad < 20; pad++)
+			writer_char(out, ' ');
+		return;
+	}
+	if (!first)
+		writer_char(out, ',');
+	writer_char(out, '"');
+	writer_str(out, name, len);
+	writer_str(out, "\":", 2);
+}
+
+static void write_counter(t_writer *out, const char *name, size_t value, bool json)
+{
+	write_field(out, name, json, false);
+	writer_number(out, value);
+	if (!json)
+		writer_char(out, '\n');
+}
+
+static void write_report(t_writer *out, const t_stats *stats, bool json)
+{
+	struct rusage usage;
+	size_t peak_rss_kb = 0;
+
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		peak_rss_kb = (size_t)usage.ru_maxrss; // kilobytes on Linux
+	writer_str(out, json ? "{\"stages_ms\":{" : "# stats\n", json ? 14 : 8);
+	for (int stage = 0; stage < STAGE_COUNT; stage++)
+	{
+		write_field(out, g_stage_names[stage], json, stage == 0);
+		write_ms(out, stats->stage_ns[stage]);
+		if (!json)
+			writer_str(out, " ms\n", 4);
+	}
+	if (json)
+		writer_char(out, '}');
+	write_counter(out, "rooms_pruned", stats->rooms_pruned, json);
+	write_counter(out, "rooms_contracted", stats->rooms_contracted, json);
+	write_counter(out, "bfs_calls", stats->bfs_calls, json);
+	write_counter(out, "edges_relaxed", stats->edges_relaxed, json);
+	write_counter(out, "augment_accepted", stats->augment_accepted, json);
+	write_counter(out, "augment_rejected", stats->augment_rejected, json);
+	write_counter(out, "arena_blocks", stats->arena_blocks, json);
+	write_counter(out, "budget_expired", stats->budget_expired, json);
+	write_counter(out, "early_stop", stats->early_stop, json);
+	write_counter(out, "peak_rss_kb", peak_rss_kb, json);
+	if (json)
+		writer_str(out, "}\n", 2);
+}
+
+// Human-readable lines on stderr, or one JSON object in options->stats_path
+bool stats_report(const t_stats *stats, const t_options *options)
+{
+	t_writer out;
+	int fd = STDERR_FILENO;
+	bool ok;
+
+	if (!options->stats)
+		return true;
+	if (options->stats_path
+		&& (fd = open(options->stats_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+		return print_error(ERR_STATS_OUTPUT, options->stats_path);
+	if (!writer_init(&out, fd))
+	{
+		if (fd != STDERR_FILENO)
+			close(fd);
+		return print_error(ERR_MEMORY, "stats");
+	}
+	write_report(&out, stats, options->stats_path != NULL);
+	ok = writer_destroy(&out);
+	if (fd != STDERR_FILENO && close(fd) < 0)
+		ok = false;
+	if (!ok)
+		return print_error(ERR_STATS_OUTPUT, options->stats_path);
+	return true;
+}
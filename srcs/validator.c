@@ -57,9 +57,9 @@ bool validate_ant_count(const char *line, int32_t *count, error_code_t *error)
 	return true;
 }
 
-bool validate_room_name(const char *name, error_code_t *error)
+bool validate_room_name(const char *name, size_t len, error_code_t *error)
 {
-	if (!name || !*name || !error)
+	if (!name || !len || !error)
 	{
 		if (error)
 			*error = ERR_ROOM_NAME_INVALID;
@@ -81,7 +81,7 @@ bool validate_room_name(const char *name, error_code_t *error)
 	}
 
 	// Check for forbidden characters
-	for (const char *p = name; *p; p++)
+	for (const char *p = name; p < name + len; p++)
 	{
 		if (*p == ' ' || *p == '\t')
 		{
@@ -102,7 +102,6 @@ bool validate_room_name(const char *name, error_code_t *error)
 	}
 
 	// Check for reasonable name length
-	size_t len = ft_strlen(name);
 	if (len > 255) // Reasonable limit
 	{
 		*error = ERR_ROOM_NAME_INVALID;
@@ -113,34 +112,35 @@ bool validate_room_name(const char *name, error_code_t *error)
 	return true;
 }
 
-// Helper function for clean integer validation
-static bool is_valid_integer(const char *str)
+// One coordinate in [str, end): optional sign, then digits only, within
+// the int32_t range. Leading zeros are fine, as they were for strtol.
+static bool is_valid_coordinate(const char *str, const char *end)
 {
-	if (!str || !*str)
-		return false;
-
-	const char *p = str;
+	bool negative = false;
+	uint64_t value = 0;
 
 	// Allow optional sign
-	if (*p == '-' || *p == '+')
-		p++;
+	if (str < end && (*str == '-' || *str == '+'))
+		negative = *str++ == '-';
 
 	// Must have at least one digit after sign
-	if (*p == '\0')
+	if (str == end)
 		return false;
 
-	// Only digits allowed
-	while (*p)
+	for (; str < end; str++)
 	{
-		if (*p < '0' || *p > '9')
+		if (*str < '0' || *str > '9')
+			return false;
+		value = value * 10 + (uint64_t)(*str - '0');
+		if (value > (uint64_t)INT32_MAX + 1)
 			return false;
-		p++;
 	}
-
-	return true;
+	return negative || value <= INT32_MAX;
 }
 
-bool validate_coordinates(const char *x_str, const char *y_str, error_code_t *error)
+// Both coordinates are [start, end) spans of the line
+bool validate_coordinates(const char *x_str, const char *x_end, const char *y_str, const char *y_end,
+	error_code_t *error)
 {
 	if (!x_str || !y_str || !error)
 	{
@@ -149,34 +149,7 @@ bool validate_coordinates(const char *x_str, const char *y_str, error_code_t *er
 		return false;
 	}
 
-	// Check for empty strings
-	if (*x_str == '\0' || *y_str == '\0')
-	{
-		*error = ERR_ROOM_COORDINATES;
-		return false;
-	}
-
-	// Simple validation: must be integers only (with optional sign)
-	if (!is_valid_integer(x_str) || !is_valid_integer(y_str))
-	{
-		*error = ERR_ROOM_COORDINATES;
-		return false;
-	}
-
-	// Parse and range check
-	char *endptr;
-	errno = 0;
-
-	long x = ft_strtol(x_str, &endptr, 10);
-	if (errno == ERANGE || x < INT32_MIN || x > INT32_MAX)
-	{
-		*error = ERR_ROOM_COORDINATES;
-		return false;
-	}
-
-	errno = 0;
-	long y = ft_strtol(y_str, &endptr, 10);
-	if (errno == ERANGE || y < INT32_MIN || y > INT32_MAX)
+	if (!is_valid_coordinate(x_str, x_end) || !is_valid_coordinate(y_str, y_end))
 	{
 		*error = ERR_ROOM_COORDINATES;
 		return false;
@@ -186,7 +159,7 @@ bool validate_coordinates(const char *x_str, const char *y_str, error_code_t *er
 	return true;
 }
 
-bool is_room_line(const char *line)
+bool is_room_line(const char *line, const line_scan_t *scan)
 {
 	if (!line || !*line)
 		return false;
@@ -195,6 +168,13 @@ bool is_room_line(const char *line)
 	if (*line == '#')
 		return false;
 
+	// The usual shapes are settled by the scan: a single token is never
+	// a room, "name x y" always is
+	if (scan->blanks == 0)
+		return false;
+	if (scan_is_room_shape(line, scan))
+		return true;
+
 	// Simple token counting approach
 	const char *p = line;
 	int token_count = 0;
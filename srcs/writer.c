@@ -0,0 +1,123 @@
+#include "lem_in.h"
+
+/* ============================================================================
+ *                               OUTPUT WRITER
+ * ============================================================================ */
+
+static const char g_digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// formatte un entier non signe dans dst, deux chiffres a la fois
+static size_t format_number(char *dst, size_t n)
+{
+	char tmp[20];
+	size_t pos = sizeof(tmp);
+
+	while (n >= 100)
+	{
+		size_t pair = (n % 100) * 2;
+		n /= 100;
+		tmp[--pos] = g_digit_pairs[pair + 1];
+		tmp[--pos] = g_digit_pairs[pair];
+	}
+	if (n >= 10)
+	{
+		tmp[--pos] = g_digit_pairs[n * 2 + 1];
+		tmp[--pos] = g_digit_pairs[n * 2];
+	}
+	else
+		tmp[--pos] = (char)('0' + n);
+	memcpy(dst, tmp + pos, sizeof(tmp) - pos);
+	return sizeof(tmp) - pos;
+}
+
+bool writer_init(t_writer *writer, int fd)
+{
+	writer->fd = fd;
+	writer->len = 0;
+	writer->failed = false;
+	if (!(writer->buf = malloc(OUTPUT_BUFFER_SIZE)))
+		return false;
+	return true;
+}
+
+// vide le buffer sur le fd, en reprenant apres les ecritures partielles
+bool writer_flush(t_writer *writer)
+{
+	size_t done = 0;
+	ssize_t written;
+
+	while (done < writer->len && !writer->failed)
+	{
+		written = write(writer->fd, writer->buf + done, writer->len - done);
+		if (written < 0 && errno != EINTR)
+			writer->failed = true;
+		else if (written > 0)
+			done += written;
+	}
+	writer->len = 0;
+	return !writer->failed;
+}
+
+// s'assurer qu'il reste au moins size octets libres dans le buffer
+static inline char *writer_reserve(t_writer *writer, size_t size)
+{
+	if (writer->len + size > OUTPUT_BUFFER_SIZE)
+		writer_flush(writer);
+	return writer->buf + writer->len;
+}
+
+void writer_char(t_writer *writer, char c)
+{
+	*writer_reserve(writer, 1) = c;
+	writer->len++;
+}
+
+void writer_str(t_writer *writer, const char *str, size_t len)
+{
+	while (len > 0)
+	{
+		size_t chunk = len < OUTPUT_BUFFER_SIZE ? len : OUTPUT_BUFFER_SIZE;
+		memcpy(writer_reserve(writer, chunk), str, chunk);
+		writer->len += chunk;
+		str += chunk;
+		len -= chunk;
+	}
+}
+
+void writer_number(t_writer *writer, size_t n)
+{
+	writer->len += format_number(writer_reserve(writer, 20), n);
+}
+
+// ecrit "L<ant>-<room>" ; les noms de salles font au plus 255 octets
+void writer_move(t_writer *writer, size_t ant, const char *room, size_t room_len)
+{
+	char *dst = writer_reserve(writer, room_len + 22);
+	size_t len = 0;
+
+	dst[len++] = 'L';
+	len += format_number(dst + len, ant);
+	dst[len++] = '-';
+	memcpy(dst + len, room, room_len);
+	writer->len += len + room_len;
+}
+
+// flush final puis liberation du buffer
+bool writer_destroy(t_writer *writer)
+{
+	bool ok = writer_flush(writer);
+
+	free(writer->buf);
+	writer->buf = NULL;
+	return ok;
+}